@@ -0,0 +1,265 @@
+/*
+ * msp430.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+
+#ifndef HOST_INCLUDE_MSP430_H_
+#define HOST_INCLUDE_MSP430_H_
+
+#include <stdint.h>
+
+/*
+ * msp430.h para compilar en la PC con el simulador de periféricos (sim.h). Los registros son accesos al simulador y
+ * los valores de los bits son los del MSP430G2533. Los registros de 8 bits ocupan el byte bajo de su espacio, entonces
+ * la PC debe ser little-endian.
+ */
+
+typedef enum _sim_reg_e {
+    SIM_REG_TA0CTL, SIM_REG_TA0R, SIM_REG_TA0CCTL0, SIM_REG_TA0CCTL1, SIM_REG_TA0CCTL2,
+    SIM_REG_TA0CCR0, SIM_REG_TA0CCR1, SIM_REG_TA0CCR2, SIM_REG_TA0IV,
+    SIM_REG_TA1CTL, SIM_REG_TA1R, SIM_REG_TA1CCTL0, SIM_REG_TA1CCTL1, SIM_REG_TA1CCTL2,
+    SIM_REG_TA1CCR0, SIM_REG_TA1CCR1, SIM_REG_TA1CCR2, SIM_REG_TA1IV,
+    SIM_REG_P1IN, SIM_REG_P1OUT, SIM_REG_P1DIR, SIM_REG_P1IFG, SIM_REG_P1IES, SIM_REG_P1IE,
+    SIM_REG_P1SEL, SIM_REG_P1SEL2, SIM_REG_P1REN,
+    SIM_REG_P2IN, SIM_REG_P2OUT, SIM_REG_P2DIR, SIM_REG_P2IFG, SIM_REG_P2IES, SIM_REG_P2IE,
+    SIM_REG_P2SEL, SIM_REG_P2SEL2, SIM_REG_P2REN,
+    SIM_REG_DCOCTL, SIM_REG_BCSCTL1, SIM_REG_BCSCTL2, SIM_REG_BCSCTL3,
+    SIM_REG_UCA0CTL0, SIM_REG_UCA0CTL1, SIM_REG_UCA0BR0, SIM_REG_UCA0BR1, SIM_REG_UCA0MCTL,
+    SIM_REG_UCA0STAT, SIM_REG_UCA0RXBUF, SIM_REG_UCA0TXBUF,
+    SIM_REG_IE1, SIM_REG_IFG1, SIM_REG_IE2, SIM_REG_IFG2,
+    SIM_REG_WDTCTL,
+    SIM_REG_COUNT,
+} sim_reg_e;
+
+/**
+ * @brief Avanza el reloj virtual un acceso y regresa la dirección del registro. Usar a través de los registros.
+ */
+volatile void * sim_access(sim_reg_e reg);
+
+#define SIM_REG16(reg)  (*(volatile uint16_t *) sim_access(reg))
+#define SIM_REG8(reg)   (*(volatile uint8_t *) sim_access(reg))
+
+/* Timer0_A3 y Timer1_A3. */
+#define TA0CTL          SIM_REG16(SIM_REG_TA0CTL)
+#define TA0R            SIM_REG16(SIM_REG_TA0R)
+#define TA0CCTL0        SIM_REG16(SIM_REG_TA0CCTL0)
+#define TA0CCTL1        SIM_REG16(SIM_REG_TA0CCTL1)
+#define TA0CCTL2        SIM_REG16(SIM_REG_TA0CCTL2)
+#define TA0CCR0         SIM_REG16(SIM_REG_TA0CCR0)
+#define TA0CCR1         SIM_REG16(SIM_REG_TA0CCR1)
+#define TA0CCR2         SIM_REG16(SIM_REG_TA0CCR2)
+#define TA0IV           SIM_REG16(SIM_REG_TA0IV)
+#define TA1CTL          SIM_REG16(SIM_REG_TA1CTL)
+#define TA1R            SIM_REG16(SIM_REG_TA1R)
+#define TA1CCTL0        SIM_REG16(SIM_REG_TA1CCTL0)
+#define TA1CCTL1        SIM_REG16(SIM_REG_TA1CCTL1)
+#define TA1CCTL2        SIM_REG16(SIM_REG_TA1CCTL2)
+#define TA1CCR0         SIM_REG16(SIM_REG_TA1CCR0)
+#define TA1CCR1         SIM_REG16(SIM_REG_TA1CCR1)
+#define TA1CCR2         SIM_REG16(SIM_REG_TA1CCR2)
+#define TA1IV           SIM_REG16(SIM_REG_TA1IV)
+
+/* Puertos 1 y 2. */
+#define P1IN            SIM_REG8(SIM_REG_P1IN)
+#define P1OUT           SIM_REG8(SIM_REG_P1OUT)
+#define P1DIR           SIM_REG8(SIM_REG_P1DIR)
+#define P1IFG           SIM_REG8(SIM_REG_P1IFG)
+#define P1IES           SIM_REG8(SIM_REG_P1IES)
+#define P1IE            SIM_REG8(SIM_REG_P1IE)
+#define P1SEL           SIM_REG8(SIM_REG_P1SEL)
+#define P1SEL2          SIM_REG8(SIM_REG_P1SEL2)
+#define P1REN           SIM_REG8(SIM_REG_P1REN)
+#define P2IN            SIM_REG8(SIM_REG_P2IN)
+#define P2OUT           SIM_REG8(SIM_REG_P2OUT)
+#define P2DIR           SIM_REG8(SIM_REG_P2DIR)
+#define P2IFG           SIM_REG8(SIM_REG_P2IFG)
+#define P2IES           SIM_REG8(SIM_REG_P2IES)
+#define P2IE            SIM_REG8(SIM_REG_P2IE)
+#define P2SEL           SIM_REG8(SIM_REG_P2SEL)
+#define P2SEL2          SIM_REG8(SIM_REG_P2SEL2)
+#define P2REN           SIM_REG8(SIM_REG_P2REN)
+
+/* Basic Clock Module+. Las constantes de calibración son de solo lectura. */
+#define DCOCTL          SIM_REG8(SIM_REG_DCOCTL)
+#define BCSCTL1         SIM_REG8(SIM_REG_BCSCTL1)
+#define BCSCTL2         SIM_REG8(SIM_REG_BCSCTL2)
+#define BCSCTL3         SIM_REG8(SIM_REG_BCSCTL3)
+#define CALDCO_1MHZ     ((uint8_t) 0xB5u)
+#define CALBC1_1MHZ     ((uint8_t) 0x86u)
+#define CALDCO_8MHZ     ((uint8_t) 0x92u)
+#define CALBC1_8MHZ     ((uint8_t) 0x8Du)
+#define CALDCO_12MHZ    ((uint8_t) 0x9Eu)
+#define CALBC1_12MHZ    ((uint8_t) 0x8Eu)
+#define CALDCO_16MHZ    ((uint8_t) 0x95u)
+#define CALBC1_16MHZ    ((uint8_t) 0x8Fu)
+
+/* USCI_A0. */
+#define UCA0CTL0        SIM_REG8(SIM_REG_UCA0CTL0)
+#define UCA0CTL1        SIM_REG8(SIM_REG_UCA0CTL1)
+#define UCA0BR0         SIM_REG8(SIM_REG_UCA0BR0)
+#define UCA0BR1         SIM_REG8(SIM_REG_UCA0BR1)
+#define UCA0MCTL        SIM_REG8(SIM_REG_UCA0MCTL)
+#define UCA0STAT        SIM_REG8(SIM_REG_UCA0STAT)
+#define UCA0RXBUF       SIM_REG8(SIM_REG_UCA0RXBUF)
+#define UCA0TXBUF       SIM_REG8(SIM_REG_UCA0TXBUF)
+
+/* Special function registers y watchdog. */
+#define IE1             SIM_REG8(SIM_REG_IE1)
+#define IFG1            SIM_REG8(SIM_REG_IFG1)
+#define IE2             SIM_REG8(SIM_REG_IE2)
+#define IFG2            SIM_REG8(SIM_REG_IFG2)
+#define WDTCTL          SIM_REG16(SIM_REG_WDTCTL)
+
+/* SR. */
+#define GIE             (0x0008u)
+#define CPUOFF          (0x0010u)
+#define OSCOFF          (0x0020u)
+#define SCG0            (0x0040u)
+#define SCG1            (0x0080u)
+#define LPM0_bits       (CPUOFF)
+#define LPM1_bits       (SCG0 + CPUOFF)
+#define LPM2_bits       (SCG1 + CPUOFF)
+#define LPM3_bits       (SCG1 + SCG0 + CPUOFF)
+#define LPM4_bits       (SCG1 + SCG0 + OSCOFF + CPUOFF)
+
+/* TAxCTL. */
+#define TASSEL_0        (0x0000u)
+#define TASSEL_1        (0x0100u)
+#define TASSEL_2        (0x0200u)
+#define TASSEL_3        (0x0300u)
+#define ID_0            (0x0000u)
+#define ID_1            (0x0040u)
+#define ID_2            (0x0080u)
+#define ID_3            (0x00C0u)
+#define MC_0            (0x0000u)
+#define MC_1            (0x0010u)
+#define MC_2            (0x0020u)
+#define MC_3            (0x0030u)
+#define TACLR           (0x0004u)
+#define TAIE            (0x0002u)
+#define TAIFG           (0x0001u)
+
+/* TAxCCTLx. */
+#define CM_0            (0x0000u)
+#define CM_1            (0x4000u)
+#define CM_2            (0x8000u)
+#define CM_3            (0xC000u)
+#define CCIS_0          (0x0000u)
+#define CCIS_1          (0x1000u)
+#define CCIS_2          (0x2000u)
+#define CCIS_3          (0x3000u)
+#define SCS             (0x0800u)
+#define SCCI            (0x0400u)
+#define CAP             (0x0100u)
+#define OUTMOD_0        (0x0000u)
+#define CCIE            (0x0010u)
+#define CCI             (0x0008u)
+#define OUT             (0x0004u)
+#define COV             (0x0002u)
+#define CCIFG           (0x0001u)
+
+/* TAxIV. */
+#define TA0IV_NONE      (0x0000u)
+#define TA0IV_TACCR1    (0x0002u)
+#define TA0IV_TACCR2    (0x0004u)
+#define TA0IV_TAIFG     (0x000Au)
+#define TA1IV_NONE      (0x0000u)
+#define TA1IV_TACCR1    (0x0002u)
+#define TA1IV_TACCR2    (0x0004u)
+#define TA1IV_TAIFG     (0x000Au)
+
+/* BCSCTL1, BCSCTL2, BCSCTL3. */
+#define XT2OFF          (0x80u)
+#define XTS             (0x40u)
+#define DIVA_0          (0x00u)
+#define DIVA_1          (0x10u)
+#define DIVA_2          (0x20u)
+#define DIVA_3          (0x30u)
+#define SELM_0          (0x00u)
+#define SELM_1          (0x40u)
+#define SELM_2          (0x80u)
+#define SELM_3          (0xC0u)
+#define DIVM_0          (0x00u)
+#define DIVM_1          (0x10u)
+#define DIVM_2          (0x20u)
+#define DIVM_3          (0x30u)
+#define SELS            (0x08u)
+#define DIVS_0          (0x00u)
+#define DIVS_1          (0x02u)
+#define DIVS_2          (0x04u)
+#define DIVS_3          (0x06u)
+#define LFXT1S_0        (0x00u)
+#define LFXT1S_1        (0x10u)
+#define LFXT1S_2        (0x20u)
+#define LFXT1S_3        (0x30u)
+#define LFXT1OF         (0x01u)
+
+/* UCA0CTL1, UCA0MCTL, UCA0STAT. */
+#define UCSSEL_0        (0x00u)
+#define UCSSEL_1        (0x40u)
+#define UCSSEL_2        (0x80u)
+#define UCSSEL_3        (0xC0u)
+#define UCSWRST         (0x01u)
+#define UCBRS_0         (0x00u)
+#define UCOS16          (0x01u)
+#define UCBUSY          (0x01u)
+
+/* IE1, IFG1, IE2, IFG2. */
+#define WDTIE           (0x01u)
+#define WDTIFG          (0x01u)
+#define OFIFG           (0x02u)
+#define PORIFG          (0x04u)
+#define RSTIFG          (0x08u)
+#define UCA0RXIE        (0x01u)
+#define UCA0TXIE        (0x02u)
+#define UCA0RXIFG       (0x01u)
+#define UCA0TXIFG       (0x02u)
+
+/* WDTCTL. */
+#define WDTPW           (0x5A00u)
+#define WDTHOLD         (0x0080u)
+#define WDTTMSEL        (0x0010u)
+#define WDTCNTCL        (0x0008u)
+#define WDTSSEL         (0x0004u)
+#define WDTIS1          (0x0002u)
+#define WDTIS0          (0x0001u)
+#define WDT_ARST_1000   (WDTPW + WDTCNTCL + WDTSSEL)
+#define WDT_ARST_250    (WDTPW + WDTCNTCL + WDTSSEL + WDTIS0)
+#define WDT_ARST_16     (WDTPW + WDTCNTCL + WDTSSEL + WDTIS1)
+#define WDT_ARST_1_9    (WDTPW + WDTCNTCL + WDTSSEL + WDTIS1 + WDTIS0)
+
+/* Vectores de interrupción (índices para sim_vector_set). */
+#define PORT1_VECTOR        (2u)
+#define PORT2_VECTOR        (3u)
+#define ADC10_VECTOR        (5u)
+#define USCIAB0TX_VECTOR    (6u)
+#define USCIAB0RX_VECTOR    (7u)
+#define TIMER0_A1_VECTOR    (8u)
+#define TIMER0_A0_VECTOR    (9u)
+#define WDT_VECTOR          (10u)
+#define COMPARATORA_VECTOR  (11u)
+#define TIMER1_A1_VECTOR    (12u)
+#define TIMER1_A0_VECTOR    (13u)
+#define NMI_VECTOR          (14u)
+
+/* cl430 usa __interrupt junto con #pragma vector; en la PC, las ISRs se instalan con sim_vector_set. */
+#define __interrupt
+
+/* Intrínsecos de cl430. */
+unsigned short __get_SR_register(void);
+void __bis_SR_register(unsigned short bits);
+void __bic_SR_register(unsigned short bits);
+void __bis_SR_register_on_exit(unsigned short bits);
+void __bic_SR_register_on_exit(unsigned short bits);
+void __enable_interrupt(void);
+void __disable_interrupt(void);
+unsigned short __get_interrupt_state(void);
+void __set_interrupt_state(unsigned short state);
+void __no_operation(void);
+void __delay_cycles(unsigned long cycles);
+
+#define __even_in_range(value, bound)   (value)
+
+#endif /* HOST_INCLUDE_MSP430_H_ */
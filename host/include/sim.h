@@ -0,0 +1,102 @@
+/*
+ * sim.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+
+#ifndef HOST_INCLUDE_SIM_H_
+#define HOST_INCLUDE_SIM_H_
+
+#include <stdint.h>
+
+/*
+ * Simulador de periféricos del MSP430G2533 para compilar y ejecutar el código del HAL (src/hal) en la PC, sin cambios:
+ * host/include/msp430.h reemplaza a los registros con accesos al simulador.
+ *
+ * - Reloj virtual: cada acceso a un registro cuesta SIM_ACCESS_CYCLES ciclos de MCLK y __delay_cycles cuesta sus
+ *   ciclos. En modo de bajo consumo, el reloj salta al siguiente evento. El código que no accede a registros no avanza
+ *   el reloj, entonces la simulación corre más rápido que el tiempo real y es reproducible.
+ * - Timers: Timer0_A3 y Timer1_A3 en modo continuo o up, con SMCLK o ACLK (VLO a 12 kHz, o LFXT1 a 32768 Hz), y la
+ *   captura de ACLK en TA0CCR0 (CCI0B) que usa la calibración del VLO.
+ * - UART: USCI_A0 en modo UART, solo transmisión. Cada byte tarda 10 bits al baud rate de UCA0BRx/UCA0MCTL y SMCLK, y
+ *   sale a stdout, a un archivo o a una pseudo-terminal.
+ * - GPIO: P1 y P2. Los flancos en las entradas (sim_gpio_input o un script) activan PxIFG según PxIES.
+ * - DCO: las frecuencias calibradas (CALBC1_xMHZ/CALDCO_xMHZ) de 1, 8, 12 y 16 MHz.
+ * - Kernel: host/sim_port.c reemplaza a os/port.asm (cambio de contexto con ucontext y epílogo de las ISRs del kernel).
+ *
+ * El simulador se configura con variables de ambiente al iniciar el programa, antes de main:
+ *
+ * SIM_UART=pty|<archivo>       Salida de la UART. Por defecto, stdout.
+ * SIM_UART_THROTTLE=0          Transmitir cada byte sin esperar su tiempo al baud rate.
+ * SIM_SPEED=<factor>           Limitar el reloj virtual a factor veces el tiempo real. Por defecto, sin límite.
+ * SIM_SCRIPT=<archivo>         Eventos de GPIO programados (ver sim_script_load).
+ * SIM_TIME_LIMIT_MS=<ms>       Terminar el programa después de ms milisegundos de tiempo virtual.
+ * SIM_GPIO_TRACE=<archivo>     Registrar cada cambio de P1OUT y P2OUT con su tiempo en us.
+ */
+
+/* Ciclos de MCLK por acceso a un registro. */
+#define SIM_ACCESS_CYCLES   (4u)
+
+/* Limpiar los bits de LPM del SR al terminar la ISR, como OS_ISR con OS_LOW_POWER_IDLE. */
+#define SIM_ISR_WAKE        (0x01u)
+
+typedef void (*sim_isr_t)(void);
+
+/**
+ * @brief Instala una ISR en un vector, en lugar de #pragma vector o de OS_ISR en os/port.asm.
+ *
+ * @param vector Vector de msp430.h (por ejemplo, PORT1_VECTOR).
+ * @param isr Función de la ISR, o 0 para quitarla.
+ * @param flags SIM_ISR_WAKE o 0.
+ */
+void sim_vector_set(uint8_t vector, sim_isr_t isr, uint8_t flags);
+
+/**
+ * @brief Obtiene el tiempo virtual desde el inicio del programa.
+ *
+ * @return Tiempo en microsegundos.
+ */
+uint64_t sim_time_us(void);
+
+/**
+ * @brief Avanza el reloj virtual, procesando los eventos y las interrupciones en ese tiempo.
+ *
+ * @param us Microsegundos que avanza el reloj.
+ */
+void sim_advance_us(uint32_t us);
+
+/**
+ * @brief Cambia el nivel de pines de entrada. Un flanco activa PxIFG según PxIES, igual que en el MSP430.
+ *
+ * @param port Puerto, 1 o 2.
+ * @param mask Pines que cambian.
+ * @param level 0 para nivel bajo, otro valor para nivel alto.
+ */
+void sim_gpio_input(uint8_t port, uint8_t mask, uint8_t level);
+
+/**
+ * @brief Carga un script de eventos. Cada línea tiene un tiempo virtual en us (en orden no decreciente) y un evento:
+ *
+ * <us> gpio <puerto> <máscara> <nivel>     Igual que sim_gpio_input(puerto, máscara, nivel).
+ * <us> end                                 Terminar el programa.
+ *
+ * Las líneas vacías o que inician con # se ignoran. Los números aceptan 0x para hexadecimal.
+ *
+ * @param path Ruta del script.
+ *
+ * @return 0 si cargó el script, -1 si no pudo abrirlo o tiene un error.
+ */
+int sim_script_load(const char * path);
+
+/**
+ * @brief Cambia la salida de la UART.
+ *
+ * @param path "pty" para crear una pseudo-terminal (su ruta se imprime en stderr), o la ruta de un archivo.
+ * @param throttle 0 para transmitir cada byte sin esperar su tiempo al baud rate.
+ *
+ * @return 0 si abrió la salida, -1 si no.
+ */
+int sim_uart_open(const char * path, uint8_t throttle);
+
+#endif /* HOST_INCLUDE_SIM_H_ */
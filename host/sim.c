@@ -0,0 +1,474 @@
+/*
+ * sim.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sim_private.h"
+
+#define SIM_VECTOR_COUNT    (16u)
+
+/* Frecuencia del DCO sin calibrar, después de un reset (BCSCTL1 = 0x87, DCOCTL = 0x60). */
+#define SIM_DCO_RESET_HZ    (1100000uL)
+
+#define SIM_VLO_HZ          (12000uL)
+#define SIM_LFXT1_HZ        (32768uL)
+
+typedef struct _sim_vector_t {
+    sim_isr_t isr;
+    uint8_t flags;
+} sim_vector_t;
+
+typedef struct _sim_dco_cal_t {
+    uint8_t bcsctl1;
+    uint8_t dcoctl;
+    uint32_t hz;
+} sim_dco_cal_t;
+
+static const sim_dco_cal_t sim_dco_cals[] = {
+    { CALBC1_1MHZ, CALDCO_1MHZ, 1000000uL },
+    { CALBC1_8MHZ, CALDCO_8MHZ, 8000000uL },
+    { CALBC1_12MHZ, CALDCO_12MHZ, 12000000uL },
+    { CALBC1_16MHZ, CALDCO_16MHZ, 16000000uL },
+};
+
+uint16_t sim_regs[SIM_REG_COUNT];
+sim_ps_t sim_now;
+uint16_t sim_sr;
+
+static sim_vector_t sim_vectors[SIM_VECTOR_COUNT];
+static uint32_t sim_dco_hz = SIM_DCO_RESET_HZ;
+
+/* Registro del último acceso, pendiente de procesar. SIM_REG_COUNT si no hay. */
+static sim_reg_e sim_last_access = SIM_REG_COUNT;
+
+/*
+ * Igual que en el MSP430, el SR guardado de una ISR está en el stack de la tarea interrumpida (una variable local de
+ * sim_dispatch), entonces una ISR puede cambiar de tarea (sim_port.c) y terminar cuando la tarea vuelve a ejecutarse.
+ */
+uint16_t * sim_isr_sr;
+
+static double sim_speed;
+static struct timespec sim_real_start;
+static sim_ps_t sim_time_limit = SIM_NEVER;
+
+static void sim_commit(void);
+static void sim_run(sim_ps_t to);
+static void sim_dispatch(void);
+static void sim_pace(void);
+
+/*
+ * Se ejecuta antes de main, entonces el código de la aplicación no cambia.
+ */
+__attribute__((constructor))
+static void sim_init(void)
+{
+    const char * env;
+
+    SIM_R(SIM_REG_BCSCTL1) = 0x87u;
+    SIM_R(SIM_REG_DCOCTL) = 0x60u;
+    SIM_R(SIM_REG_WDTCTL) = 0x6900u;
+    SIM_R(SIM_REG_IFG1) = PORIFG;
+
+    sim_timer_init();
+    sim_uart_init();
+    sim_gpio_init();
+
+    env = getenv("SIM_SPEED");
+    if (0 != env)
+    {
+        sim_speed = atof(env);
+    }
+
+    env = getenv("SIM_TIME_LIMIT_MS");
+    if (0 != env)
+    {
+        sim_time_limit = (sim_ps_t) strtoull(env, 0, 0) * 1000u * SIM_PS_PER_US;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &sim_real_start);
+}
+
+void sim_exit(int status, const char * reason)
+{
+    fflush(stdout);
+    fprintf(stderr, "sim: %s (%llu us)\n", reason, (unsigned long long) (sim_now / SIM_PS_PER_US));
+    exit(status);
+}
+
+void sim_clock_changed(void)
+{
+    sim_timer_clock_changed();
+    sim_uart_clock_changed();
+}
+
+uint32_t sim_mclk_hz(void)
+{
+    return (sim_sr & CPUOFF) ? 0u : sim_dco_hz;
+}
+
+uint32_t sim_smclk_hz(void)
+{
+    return (sim_sr & SCG1) ? 0u : sim_dco_hz;
+}
+
+uint32_t sim_aclk_hz(void)
+{
+    if (sim_sr & OSCOFF)
+    {
+        return 0u;
+    }
+
+    return (LFXT1S_2 == (SIM_R(SIM_REG_BCSCTL3) & LFXT1S_3)) ? SIM_VLO_HZ : SIM_LFXT1_HZ;
+}
+
+void sim_vector_set(uint8_t vector, sim_isr_t isr, uint8_t flags)
+{
+    if (SIM_VECTOR_COUNT > vector)
+    {
+        sim_vectors[vector].isr = isr;
+        sim_vectors[vector].flags = flags;
+    }
+}
+
+uint64_t sim_time_us(void)
+{
+    return sim_now / SIM_PS_PER_US;
+}
+
+void sim_advance_us(uint32_t us)
+{
+    sim_commit();
+    sim_run(sim_now + (sim_ps_t) us * SIM_PS_PER_US);
+}
+
+volatile void * sim_access(sim_reg_e reg)
+{
+    uint32_t hz = sim_mclk_hz();
+
+    sim_commit();
+
+    if (0u != hz)
+    {
+        sim_run(sim_now + (SIM_ACCESS_CYCLES * SIM_PS_PER_S) / hz);
+    }
+
+    if (SIM_REG_TA0IV == reg || SIM_REG_TA1IV == reg)
+    {
+        // Leer TAxIV borra la bandera de mayor prioridad.
+        sim_timer_read_iv(reg);
+    }
+
+    sim_last_access = reg;
+
+    return &sim_regs[reg];
+}
+
+/*
+ * Procesa el último acceso a un registro. El acceso pudo ser una escritura, entonces sus efectos (por ejemplo,
+ * transmitir UCA0TXBUF o TACLR) ocurren hasta la siguiente entrada al simulador.
+ */
+static void sim_commit(void)
+{
+    sim_reg_e reg = sim_last_access;
+    uint8_t i;
+
+    if (SIM_REG_COUNT == reg)
+    {
+        return;
+    }
+
+    sim_last_access = SIM_REG_COUNT;
+
+    if (SIM_REG_DCOCTL == reg || SIM_REG_BCSCTL1 == reg)
+    {
+        for (i = 0u; i < sizeof(sim_dco_cals) / sizeof(sim_dco_cals[0]); i++)
+        {
+            // Solo RSELx (BCSCTL1) y DCOCTL definen la frecuencia.
+            if ((sim_dco_cals[i].bcsctl1 & 0x0Fu) == (SIM_R(SIM_REG_BCSCTL1) & 0x0Fu) &&
+                sim_dco_cals[i].dcoctl == SIM_R(SIM_REG_DCOCTL) && sim_dco_cals[i].hz != sim_dco_hz)
+            {
+                sim_dco_hz = sim_dco_cals[i].hz;
+                sim_clock_changed();
+            }
+        }
+    }
+    else if (SIM_REG_BCSCTL3 == reg)
+    {
+        sim_clock_changed();
+    }
+
+    sim_timer_commit(reg);
+    sim_uart_commit(reg);
+    sim_gpio_commit(reg);
+}
+
+static sim_ps_t sim_next_event(void)
+{
+    sim_ps_t next = sim_timer_next_event();
+    sim_ps_t event;
+
+    event = sim_uart_next_event();
+    if (event < next)
+    {
+        next = event;
+    }
+
+    event = sim_gpio_next_event();
+    if (event < next)
+    {
+        next = event;
+    }
+
+    return next;
+}
+
+/*
+ * Avanza el reloj virtual hasta to, deteniéndose en cada evento para procesar interrupciones. Una ISR puede avanzar el
+ * reloj más allá de to.
+ */
+static void sim_run(sim_ps_t to)
+{
+    sim_ps_t next;
+
+    while (sim_now < to)
+    {
+        next = sim_next_event();
+        if (next > to)
+        {
+            next = to;
+        }
+        if (next > sim_time_limit)
+        {
+            next = sim_time_limit;
+        }
+
+        if (next > sim_now)
+        {
+            sim_timer_advance(next);
+            sim_uart_advance(next);
+            sim_gpio_advance(next);
+            sim_now = next;
+        }
+
+        if (sim_now >= sim_time_limit)
+        {
+            sim_exit(EXIT_SUCCESS, "SIM_TIME_LIMIT_MS alcanzado");
+        }
+
+        sim_pace();
+        sim_dispatch();
+    }
+}
+
+/* Un vector tiene una interrupción pendiente y habilitada. */
+static uint8_t sim_vector_pending(uint8_t vector)
+{
+    switch (vector)
+    {
+    case TIMER1_A0_VECTOR:
+        return (SIM_R(SIM_REG_TA1CCTL0) & CCIE) && (SIM_R(SIM_REG_TA1CCTL0) & CCIFG);
+    case TIMER1_A1_VECTOR:
+        return ((SIM_R(SIM_REG_TA1CCTL1) & CCIE) && (SIM_R(SIM_REG_TA1CCTL1) & CCIFG)) ||
+               ((SIM_R(SIM_REG_TA1CCTL2) & CCIE) && (SIM_R(SIM_REG_TA1CCTL2) & CCIFG)) ||
+               ((SIM_R(SIM_REG_TA1CTL) & TAIE) && (SIM_R(SIM_REG_TA1CTL) & TAIFG));
+    case TIMER0_A0_VECTOR:
+        return (SIM_R(SIM_REG_TA0CCTL0) & CCIE) && (SIM_R(SIM_REG_TA0CCTL0) & CCIFG);
+    case TIMER0_A1_VECTOR:
+        return ((SIM_R(SIM_REG_TA0CCTL1) & CCIE) && (SIM_R(SIM_REG_TA0CCTL1) & CCIFG)) ||
+               ((SIM_R(SIM_REG_TA0CCTL2) & CCIE) && (SIM_R(SIM_REG_TA0CCTL2) & CCIFG)) ||
+               ((SIM_R(SIM_REG_TA0CTL) & TAIE) && (SIM_R(SIM_REG_TA0CTL) & TAIFG));
+    case USCIAB0RX_VECTOR:
+        return 0u != (SIM_R(SIM_REG_IE2) & SIM_R(SIM_REG_IFG2) & UCA0RXIE);
+    case USCIAB0TX_VECTOR:
+        return 0u != (SIM_R(SIM_REG_IE2) & SIM_R(SIM_REG_IFG2) & UCA0TXIE);
+    case PORT2_VECTOR:
+        return 0u != (SIM_R(SIM_REG_P2IE) & SIM_R(SIM_REG_P2IFG));
+    case PORT1_VECTOR:
+        return 0u != (SIM_R(SIM_REG_P1IE) & SIM_R(SIM_REG_P1IFG));
+    default:
+        return 0u;
+    }
+}
+
+/*
+ * Ejecuta las interrupciones pendientes, de mayor a menor prioridad (el vector más alto primero), mientras GIE está
+ * activo. Igual que el MSP430, la ISR se ejecuta con GIE y los bits de LPM desactivados, y al terminar recupera el SR
+ * anterior, con los cambios de __bic_SR_register_on_exit.
+ */
+static void sim_dispatch(void)
+{
+    uint8_t vector;
+    uint16_t sr;
+    uint16_t * outer_sr;
+    char reason[48];
+
+    while (sim_sr & GIE)
+    {
+        vector = SIM_VECTOR_COUNT;
+        while (vector-- && !sim_vector_pending(vector));
+
+        if (SIM_VECTOR_COUNT <= vector)
+        {
+            return;
+        }
+
+        if (0 == sim_vectors[vector].isr)
+        {
+            snprintf(reason, sizeof(reason), "vector %u sin ISR", vector);
+            sim_exit(EXIT_FAILURE, reason);
+        }
+
+        // Las banderas de CCR0 se borran al aceptar la interrupción.
+        if (TIMER0_A0_VECTOR == vector)
+        {
+            SIM_R(SIM_REG_TA0CCTL0) &= ~CCIFG;
+        }
+        else if (TIMER1_A0_VECTOR == vector)
+        {
+            SIM_R(SIM_REG_TA1CCTL0) &= ~CCIFG;
+        }
+
+        sr = sim_sr;
+        outer_sr = sim_isr_sr;
+        sim_isr_sr = &sr;
+        sim_sr &= SCG0;
+        sim_clock_changed();
+
+        sim_vectors[vector].isr();
+        sim_commit();
+
+        sim_isr_sr = outer_sr;
+        sim_sr = sr;
+        if (sim_vectors[vector].flags & SIM_ISR_WAKE)
+        {
+            sim_sr &= ~LPM4_bits;
+        }
+        sim_clock_changed();
+    }
+}
+
+/*
+ * Con SIM_SPEED, espera hasta que el tiempo real alcanza al reloj virtual dividido entre el factor.
+ */
+static void sim_pace(void)
+{
+    struct timespec real;
+    double ahead;
+
+    if (0.0 >= sim_speed)
+    {
+        return;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &real);
+
+    ahead = ((double) sim_now / (double) SIM_PS_PER_S) / sim_speed -
+            ((double) (real.tv_sec - sim_real_start.tv_sec) + (double) (real.tv_nsec - sim_real_start.tv_nsec) * 1e-9);
+
+    if (ahead > 0.001)
+    {
+        real.tv_sec = (time_t) ahead;
+        real.tv_nsec = (long) ((ahead - (double) real.tv_sec) * 1e9);
+        nanosleep(&real, 0);
+    }
+}
+
+/*
+ * Cambia el SR. Con GIE, ejecuta las interrupciones pendientes. Con CPUOFF, el CPU duerme: el reloj salta de evento en
+ * evento hasta que una ISR limpia los bits de LPM del SR guardado.
+ */
+static void sim_set_sr(uint16_t sr)
+{
+    sim_ps_t next;
+
+    sim_commit();
+
+    sim_sr = sr;
+    sim_clock_changed();
+    sim_dispatch();
+
+    while (sim_sr & CPUOFF)
+    {
+        next = sim_next_event();
+
+        if (SIM_NEVER == next)
+        {
+            sim_exit((sim_sr & GIE) ? EXIT_SUCCESS : EXIT_FAILURE, "CPU en bajo consumo sin eventos pendientes");
+        }
+
+        sim_run(next);
+    }
+}
+
+unsigned short __get_SR_register(void)
+{
+    return sim_sr;
+}
+
+void __bis_SR_register(unsigned short bits)
+{
+    sim_set_sr(sim_sr | bits);
+}
+
+void __bic_SR_register(unsigned short bits)
+{
+    sim_set_sr(sim_sr & ~bits);
+}
+
+void __bis_SR_register_on_exit(unsigned short bits)
+{
+    if (0 != sim_isr_sr)
+    {
+        *sim_isr_sr |= bits;
+    }
+}
+
+void __bic_SR_register_on_exit(unsigned short bits)
+{
+    if (0 != sim_isr_sr)
+    {
+        *sim_isr_sr &= ~bits;
+    }
+}
+
+void __enable_interrupt(void)
+{
+    sim_set_sr(sim_sr | GIE);
+}
+
+void __disable_interrupt(void)
+{
+    sim_set_sr(sim_sr & ~GIE);
+}
+
+unsigned short __get_interrupt_state(void)
+{
+    return sim_sr & GIE;
+}
+
+void __set_interrupt_state(unsigned short state)
+{
+    sim_set_sr((sim_sr & ~GIE) | (state & GIE));
+}
+
+void __no_operation(void)
+{
+    __delay_cycles(1u);
+}
+
+void __delay_cycles(unsigned long cycles)
+{
+    uint32_t hz = sim_mclk_hz();
+
+    sim_commit();
+
+    if (0u != hz)
+    {
+        sim_run(sim_now + ((sim_ps_t) cycles * SIM_PS_PER_S) / hz);
+    }
+}
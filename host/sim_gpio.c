@@ -0,0 +1,217 @@
+/*
+ * sim_gpio.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim_private.h"
+
+#define SIM_GPIO_PORTS      (2u)
+
+/* Registros de un puerto, en el orden de sim_reg_e a partir de PxIN. */
+#define GPIO_IN             (0u)
+#define GPIO_OUT            (1u)
+#define GPIO_DIR            (2u)
+#define GPIO_IFG            (3u)
+#define GPIO_IES            (4u)
+
+#define GPIO_REG(p, r)      (SIM_R(sim_gpio_base[(p)] + (r)))
+
+typedef enum _sim_script_action_e {
+    SIM_SCRIPT_GPIO,
+    SIM_SCRIPT_END,
+} sim_script_action_e;
+
+typedef struct _sim_script_event_t {
+    sim_ps_t time;
+    sim_script_action_e action;
+    uint8_t port;
+    uint8_t mask;
+    uint8_t level;
+} sim_script_event_t;
+
+static const sim_reg_e sim_gpio_base[SIM_GPIO_PORTS] = { SIM_REG_P1IN, SIM_REG_P2IN };
+
+/* Nivel de los pines de entrada; PxIN combina este nivel con PxOUT en los pines de salida. */
+static uint8_t sim_gpio_levels[SIM_GPIO_PORTS];
+static uint8_t sim_gpio_traced[SIM_GPIO_PORTS];
+static FILE * sim_gpio_trace;
+
+static sim_script_event_t * sim_script;
+static size_t sim_script_length;
+static size_t sim_script_next;
+
+static void gpio_update_in(uint8_t p)
+{
+    uint8_t dir = (uint8_t) GPIO_REG(p, GPIO_DIR);
+
+    GPIO_REG(p, GPIO_IN) = (uint8_t) ((sim_gpio_levels[p] & ~dir) | (GPIO_REG(p, GPIO_OUT) & dir));
+}
+
+void sim_gpio_init(void)
+{
+    const char * env;
+
+    env = getenv("SIM_GPIO_TRACE");
+    if (0 != env)
+    {
+        sim_gpio_trace = fopen(env, "w");
+        if (0 == sim_gpio_trace)
+        {
+            sim_exit(EXIT_FAILURE, "no se pudo abrir SIM_GPIO_TRACE");
+        }
+    }
+
+    env = getenv("SIM_SCRIPT");
+    if (0 != env && 0 != sim_script_load(env))
+    {
+        sim_exit(EXIT_FAILURE, "no se pudo cargar SIM_SCRIPT");
+    }
+}
+
+void sim_gpio_input(uint8_t port, uint8_t mask, uint8_t level)
+{
+    uint8_t p = port - 1u;
+    uint8_t old;
+    uint8_t edges;
+
+    if (SIM_GPIO_PORTS <= p)
+    {
+        return;
+    }
+
+    old = sim_gpio_levels[p];
+    sim_gpio_levels[p] = level ? (old | mask) : (old & ~mask);
+
+    // Flanco de subida con PxIES = 0 o de bajada con PxIES = 1, solo en pines de entrada.
+    edges = (uint8_t) ((old ^ sim_gpio_levels[p]) & ~GPIO_REG(p, GPIO_DIR));
+    edges &= (uint8_t) (level ? ~GPIO_REG(p, GPIO_IES) : GPIO_REG(p, GPIO_IES));
+
+    GPIO_REG(p, GPIO_IFG) |= edges;
+
+    gpio_update_in(p);
+}
+
+int sim_script_load(const char * path)
+{
+    FILE * file = fopen(path, "r");
+    char line[128];
+    char action[16];
+    unsigned long long us;
+    unsigned int port;
+    unsigned int mask;
+    unsigned int level;
+    sim_script_event_t event;
+    sim_script_event_t * events;
+    int fields;
+
+    if (0 == file)
+    {
+        return -1;
+    }
+
+    while (0 != fgets(line, sizeof(line), file))
+    {
+        fields = sscanf(line, "%llu %15s %i %i %i", &us, action, &port, &mask, &level);
+
+        if (0 >= fields || '#' == line[strspn(line, " \t")])
+        {
+            continue;
+        }
+
+        memset(&event, 0, sizeof(event));
+        event.time = (sim_ps_t) us * SIM_PS_PER_US;
+
+        if (5 == fields && 0 == strcmp(action, "gpio"))
+        {
+            event.action = SIM_SCRIPT_GPIO;
+            event.port = (uint8_t) port;
+            event.mask = (uint8_t) mask;
+            event.level = (uint8_t) level;
+        }
+        else if (2 == fields && 0 == strcmp(action, "end"))
+        {
+            event.action = SIM_SCRIPT_END;
+        }
+        else
+        {
+            fprintf(stderr, "sim: error en %s: %s", path, line);
+            fclose(file);
+            return -1;
+        }
+
+        if (0u != sim_script_length && event.time < sim_script[sim_script_length - 1u].time)
+        {
+            fprintf(stderr, "sim: tiempo fuera de orden en %s: %s", path, line);
+            fclose(file);
+            return -1;
+        }
+
+        events = realloc(sim_script, (sim_script_length + 1u) * sizeof(event));
+        if (0 == events)
+        {
+            fclose(file);
+            return -1;
+        }
+
+        sim_script = events;
+        sim_script[sim_script_length++] = event;
+    }
+
+    fclose(file);
+
+    return 0;
+}
+
+void sim_gpio_commit(sim_reg_e reg)
+{
+    uint8_t p;
+
+    for (p = 0u; p < SIM_GPIO_PORTS; p++)
+    {
+        if (sim_gpio_base[p] + GPIO_OUT == reg || sim_gpio_base[p] + GPIO_DIR == reg)
+        {
+            gpio_update_in(p);
+
+            if (0 != sim_gpio_trace && sim_gpio_traced[p] != (uint8_t) GPIO_REG(p, GPIO_OUT))
+            {
+                sim_gpio_traced[p] = (uint8_t) GPIO_REG(p, GPIO_OUT);
+                fprintf(sim_gpio_trace, "%llu P%uOUT 0x%02X\n", (unsigned long long) (sim_now / SIM_PS_PER_US),
+                        p + 1u, sim_gpio_traced[p]);
+                fflush(sim_gpio_trace);
+            }
+        }
+    }
+}
+
+sim_ps_t sim_gpio_next_event(void)
+{
+    if (sim_script_next >= sim_script_length)
+    {
+        return SIM_NEVER;
+    }
+
+    // Un evento en el pasado (por ejemplo, en el tiempo 0) ocurre en cuanto avanza el reloj.
+    return (sim_script[sim_script_next].time > sim_now) ? sim_script[sim_script_next].time : sim_now + 1u;
+}
+
+void sim_gpio_advance(sim_ps_t to)
+{
+    sim_script_event_t * event;
+
+    while (sim_script_next < sim_script_length && sim_script[sim_script_next].time <= to)
+    {
+        event = &sim_script[sim_script_next++];
+
+        if (SIM_SCRIPT_END == event->action)
+        {
+            sim_now = to;
+            sim_exit(EXIT_SUCCESS, "fin del script");
+        }
+
+        sim_gpio_input(event->port, event->mask, event->level);
+    }
+}
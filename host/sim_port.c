@@ -0,0 +1,133 @@
+/*
+ * sim_port.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include <stdlib.h>
+#include <ucontext.h>
+
+#include "sim_private.h"
+
+#include "os_private.h"
+
+/*
+ * Port del kernel para la PC: el equivalente de os/port.asm. Cada tarea extendida se ejecuta en un ucontext con su
+ * propio stack de la PC; task_contexts solo guarda el SR de la tarea. Las ISRs declaradas con OS_ISR en os/port.asm
+ * se instalan aquí con el mismo epílogo (port_isr_exit), entonces una ISR que activa una tarea cambia de contexto sobre
+ * el stack de la tarea interrumpida, igual que en el MSP430.
+ */
+
+/* Stack de la PC para cada tarea extendida. El código de la PC usa mucho más stack que el del MSP430. */
+#define PORT_STACK_BYTES    (64u * 1024u)
+
+/*
+ * task_context_reset escribe el SP inicial de la tarea, distinto de 0. port_context_switch escribe 0 al guardar un
+ * contexto, entonces un SP distinto de 0 indica que la tarea debe comenzar desde su función.
+ */
+#define PORT_CONTEXT_SAVED  (0u)
+
+static ucontext_t port_contexts[OS_EXTENDED_TASK_COUNT];
+static uint16_t * port_isr_sr[OS_EXTENDED_TASK_COUNT];
+static uint8_t port_stacks[OS_EXTENDED_TASK_COUNT][PORT_STACK_BYTES] __attribute__((aligned(16)));
+
+static uint8_t port_context_id(volatile uint16_t * context)
+{
+    return (uint8_t) ((context - &task_contexts[0][0]) / TASK_STACK_SIZE);
+}
+
+static void port_task_start(void)
+{
+    TASK_CONFIG(current_task).task_function();
+
+    // En el MSP430, la tarea retornaría a una dirección inválida.
+    sim_exit(EXIT_FAILURE, "una tarea extendida retornó sin llamar a os_task_terminate");
+}
+
+void port_context_switch(volatile uint16_t * save_context, volatile uint16_t * restore_context)
+{
+    uint8_t restore_id = port_context_id(restore_context);
+    uint8_t save_id = 0u;
+
+    if (PORT_CONTEXT_SAVED != restore_context[TASK_CONTEXT_SP])
+    {
+        // El contexto inicial de una tarea que terminó se carga sobre su propio stack (save_context es 0), pero el
+        // marco de la tarea ya no se usa: makecontext solo escribe al inicio del stack.
+        getcontext(&port_contexts[restore_id]);
+        port_contexts[restore_id].uc_stack.ss_sp = port_stacks[restore_id];
+        port_contexts[restore_id].uc_stack.ss_size = PORT_STACK_BYTES;
+        port_contexts[restore_id].uc_link = 0;
+        makecontext(&port_contexts[restore_id], port_task_start, 0);
+
+        restore_context[TASK_CONTEXT_SP] = PORT_CONTEXT_SAVED;
+        port_isr_sr[restore_id] = 0;
+    }
+
+    if (0 != save_context)
+    {
+        save_id = port_context_id(save_context);
+        save_context[TASK_CONTEXT_SR] = sim_sr;
+        save_context[TASK_CONTEXT_SP] = PORT_CONTEXT_SAVED;
+        port_isr_sr[save_id] = sim_isr_sr;
+    }
+
+    // Equivalente a RETI en port_context_switch: la tarea continúa con su SR, incluyendo GIE.
+    sim_sr = restore_context[TASK_CONTEXT_SR];
+    sim_isr_sr = port_isr_sr[restore_id];
+    sim_clock_changed();
+
+    if (0 != save_context)
+    {
+        swapcontext(&port_contexts[save_id], &port_contexts[restore_id]);
+    }
+    else
+    {
+        setcontext(&port_contexts[restore_id]);
+    }
+}
+
+/*
+ * Epílogo común de las ISRs del kernel (os_isr_exit en os/port.asm). Con OS_LOW_POWER_IDLE, los bits de LPM se limpian
+ * con SIM_ISR_WAKE.
+ */
+static void port_isr_exit(void)
+{
+    if (os_switch_pending)
+    {
+        os_switch_pending = 0u;
+        scheduler_preempt();
+    }
+}
+
+#define PORT_OS_ISR(entry, handler)\
+    static void entry(void)\
+    {\
+        handler();\
+        port_isr_exit();\
+    }
+
+PORT_OS_ISR(systick_isr, systick_handler)
+
+#ifdef OS_GPIO_IRQ
+PORT_OS_ISR(gpio_port1_isr, gpio_port1_handler)
+PORT_OS_ISR(gpio_port2_isr, gpio_port2_handler)
+#endif /* OS_GPIO_IRQ */
+
+__attribute__((constructor))
+static void port_vectors_init(void)
+{
+#ifdef OS_LOW_POWER_IDLE
+    uint8_t flags = SIM_ISR_WAKE;
+#else
+    uint8_t flags = 0u;
+#endif /* OS_LOW_POWER_IDLE */
+
+#ifdef SYSTICK_BASE_TA0_0
+    sim_vector_set(TIMER0_A0_VECTOR, systick_isr, flags);
+#endif /* SYSTICK_BASE_TA0_0 */
+
+#ifdef OS_GPIO_IRQ
+    sim_vector_set(PORT1_VECTOR, gpio_port1_isr, flags);
+    sim_vector_set(PORT2_VECTOR, gpio_port2_isr, flags);
+#endif /* OS_GPIO_IRQ */
+}
@@ -0,0 +1,82 @@
+/*
+ * sim_private.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+
+#ifndef HOST_SIM_PRIVATE_H_
+#define HOST_SIM_PRIVATE_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "msp430.h"
+#include "sim.h"
+
+/* El reloj virtual cuenta picosegundos: un ciclo a 16 MHz son 62500 ps. */
+typedef uint64_t sim_ps_t;
+
+#define SIM_PS_PER_S        (1000000000000uLL)
+#define SIM_PS_PER_US       (1000000uLL)
+#define SIM_NEVER           (UINT64_MAX)
+
+/* Valor de un registro sin pasar por sim_access (sin avanzar el reloj). */
+#define SIM_R(reg)          (sim_regs[(reg)])
+
+extern uint16_t sim_regs[SIM_REG_COUNT];
+extern sim_ps_t sim_now;
+extern uint16_t sim_sr;
+
+/* SR guardado de la ISR en ejecución, que recupera el equivalente a RETI, o 0 fuera de una ISR. */
+extern uint16_t * sim_isr_sr;
+
+/**
+ * @brief Frecuencia de MCLK (el DCO), en Hz. 0 si el CPU está apagado.
+ */
+uint32_t sim_mclk_hz(void);
+
+/**
+ * @brief Frecuencia de SMCLK (el DCO), en Hz. 0 en LPM2 o más profundo.
+ */
+uint32_t sim_smclk_hz(void);
+
+/**
+ * @brief Frecuencia de ACLK (VLO o LFXT1), en Hz. 0 en LPM4.
+ */
+uint32_t sim_aclk_hz(void);
+
+/**
+ * @brief Avisa a los periféricos que cambió el SR o la configuración de los clocks.
+ */
+void sim_clock_changed(void);
+
+/**
+ * @brief Termina el programa, con el mensaje indicado en stderr.
+ */
+void sim_exit(int status, const char * reason);
+
+/*
+ * Cada periférico procesa el acceso anterior a uno de sus registros (commit), da el tiempo de su siguiente evento
+ * (next_event, SIM_NEVER si no hay) y avanza su estado hasta un tiempo que no pasa de ese evento (advance).
+ * clock_changed se llama cuando cambia la frecuencia de un clock, con el estado ya avanzado hasta sim_now.
+ */
+void sim_timer_init(void);
+void sim_timer_commit(sim_reg_e reg);
+sim_ps_t sim_timer_next_event(void);
+void sim_timer_advance(sim_ps_t to);
+void sim_timer_clock_changed(void);
+void sim_timer_read_iv(sim_reg_e reg);
+
+void sim_uart_init(void);
+void sim_uart_commit(sim_reg_e reg);
+sim_ps_t sim_uart_next_event(void);
+void sim_uart_advance(sim_ps_t to);
+void sim_uart_clock_changed(void);
+
+void sim_gpio_init(void);
+void sim_gpio_commit(sim_reg_e reg);
+sim_ps_t sim_gpio_next_event(void);
+void sim_gpio_advance(sim_ps_t to);
+
+#endif /* HOST_SIM_PRIVATE_H_ */
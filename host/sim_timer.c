@@ -0,0 +1,295 @@
+/*
+ * sim_timer.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include "sim_private.h"
+
+#define SIM_TIMER_COUNT     (2u)
+#define SIM_TIMER_CCRS      (3u)
+
+/* Registros de un timer, en el orden de sim_reg_e a partir de TAxCTL. */
+#define TIMER_CTL           (0u)
+#define TIMER_R             (1u)
+#define TIMER_CCTL(i)       (2u + (i))
+#define TIMER_CCR(i)        (5u + (i))
+#define TIMER_IV            (8u)
+
+#define TIMER_REG(t, r)     (SIM_R(sim_timers[(t)].base + (r)))
+
+typedef struct _sim_timer_t {
+    sim_reg_e base;                     /* TAxCTL. */
+    uint32_t hz;                        /* Frecuencia del contador, 0 si está detenido. */
+    sim_ps_t period;                    /* Picosegundos por cuenta. */
+    sim_ps_t next_count;                /* Tiempo del siguiente incremento de TAxR. */
+} sim_timer_t;
+
+static sim_timer_t sim_timers[SIM_TIMER_COUNT] = {
+    { .base = SIM_REG_TA0CTL },
+    { .base = SIM_REG_TA1CTL },
+};
+
+/* Tiempo del último flanco de subida de ACLK, para la captura de TA0CCR0 con CCIS_1 (CCI0B = ACLK). */
+static sim_ps_t sim_aclk_edge;
+
+static uint32_t timer_hz(uint8_t t)
+{
+    uint16_t ctl = TIMER_REG(t, TIMER_CTL);
+    uint32_t hz;
+
+    if (MC_0 == (ctl & MC_3))
+    {
+        return 0u;
+    }
+
+    switch (ctl & TASSEL_3)
+    {
+    case TASSEL_1:
+        hz = sim_aclk_hz();
+        break;
+    case TASSEL_2:
+        hz = sim_smclk_hz();
+        break;
+    default:
+        // TACLK e INCLK no están simulados.
+        hz = 0u;
+        break;
+    }
+
+    return hz >> ((ctl & ID_3) >> 6u);
+}
+
+/* Cuentas hasta que TAxR llega a target, en el módulo del modo del timer. */
+static uint32_t timer_counts_until(uint8_t t, uint16_t target)
+{
+    uint32_t modulus = 0x10000uL;
+    uint32_t counts;
+
+    if (MC_1 == (TIMER_REG(t, TIMER_CTL) & MC_3))
+    {
+        // Modo up: cuenta de 0 a TAxCCR0.
+        modulus = (uint32_t) TIMER_REG(t, TIMER_CCR(0u)) + 1u;
+        if (target >= modulus)
+        {
+            return 0u;
+        }
+    }
+
+    counts = ((uint32_t) target + modulus - TIMER_REG(t, TIMER_R) % modulus) % modulus;
+
+    return (0u == counts) ? modulus : counts;
+}
+
+static uint8_t timer_captures_aclk(uint8_t t, uint8_t i)
+{
+    uint16_t cctl = TIMER_REG(t, TIMER_CCTL(i));
+
+    return (0u == t && 0u == i && (cctl & CAP) && CCIS_1 == (cctl & CCIS_3) && (cctl & CM_1));
+}
+
+/* Incrementa TAxR una cuenta y activa las banderas de comparación y de desborde. */
+static void timer_count(uint8_t t)
+{
+    uint16_t r = TIMER_REG(t, TIMER_R);
+    uint8_t i;
+
+    if (MC_1 == (TIMER_REG(t, TIMER_CTL) & MC_3) && r >= TIMER_REG(t, TIMER_CCR(0u)))
+    {
+        r = 0u;
+    }
+    else
+    {
+        r++;
+    }
+
+    TIMER_REG(t, TIMER_R) = r;
+
+    if (0u == r)
+    {
+        TIMER_REG(t, TIMER_CTL) |= TAIFG;
+    }
+
+    for (i = 0u; i < SIM_TIMER_CCRS; i++)
+    {
+        if (!(TIMER_REG(t, TIMER_CCTL(i)) & CAP) && r == TIMER_REG(t, TIMER_CCR(i)))
+        {
+            TIMER_REG(t, TIMER_CCTL(i)) |= CCIFG;
+        }
+    }
+}
+
+void sim_timer_init(void)
+{
+    sim_aclk_edge = 0u;
+}
+
+void sim_timer_commit(sim_reg_e reg)
+{
+    uint8_t t;
+
+    for (t = 0u; t < SIM_TIMER_COUNT; t++)
+    {
+        if (sim_timers[t].base + TIMER_CTL == reg)
+        {
+            if (TIMER_REG(t, TIMER_CTL) & TACLR)
+            {
+                TIMER_REG(t, TIMER_CTL) &= ~TACLR;
+                TIMER_REG(t, TIMER_R) = 0u;
+            }
+
+            sim_timer_clock_changed();
+        }
+    }
+}
+
+sim_ps_t sim_timer_next_event(void)
+{
+    sim_ps_t next = SIM_NEVER;
+    sim_ps_t event;
+    uint32_t counts;
+    uint32_t min_counts;
+    uint32_t aclk_hz;
+    uint8_t t;
+    uint8_t i;
+
+    for (t = 0u; t < SIM_TIMER_COUNT; t++)
+    {
+        if (0u == sim_timers[t].hz)
+        {
+            continue;
+        }
+
+        // Desborde (TAIFG) o comparación con cualquier CCR en modo de comparación.
+        min_counts = timer_counts_until(t, 0u);
+        for (i = 0u; i < SIM_TIMER_CCRS; i++)
+        {
+            if (!(TIMER_REG(t, TIMER_CCTL(i)) & CAP))
+            {
+                counts = timer_counts_until(t, TIMER_REG(t, TIMER_CCR(i)));
+                if (0u != counts && counts < min_counts)
+                {
+                    min_counts = counts;
+                }
+            }
+        }
+
+        event = sim_timers[t].next_count + (sim_ps_t) (min_counts - 1u) * sim_timers[t].period;
+        if (event < next)
+        {
+            next = event;
+        }
+    }
+
+    aclk_hz = sim_aclk_hz();
+    if (0u != aclk_hz && timer_captures_aclk(0u, 0u))
+    {
+        event = sim_aclk_edge + SIM_PS_PER_S / aclk_hz;
+        if (event <= sim_now)
+        {
+            event = sim_now + 1u;
+        }
+        if (event < next)
+        {
+            next = event;
+        }
+    }
+
+    return next;
+}
+
+void sim_timer_advance(sim_ps_t to)
+{
+    sim_ps_t counts;
+    uint32_t aclk_hz;
+    uint8_t t;
+
+    for (t = 0u; t < SIM_TIMER_COUNT; t++)
+    {
+        if (0u == sim_timers[t].hz || to < sim_timers[t].next_count)
+        {
+            continue;
+        }
+
+        // to no pasa del siguiente evento: las cuentas anteriores a la última no activan banderas.
+        counts = (to - sim_timers[t].next_count) / sim_timers[t].period + 1u;
+        sim_timers[t].next_count += counts * sim_timers[t].period;
+
+        if (MC_1 == (TIMER_REG(t, TIMER_CTL) & MC_3))
+        {
+            while (counts--)
+            {
+                timer_count(t);
+            }
+        }
+        else
+        {
+            TIMER_REG(t, TIMER_R) += (uint16_t) (counts - 1u);
+            timer_count(t);
+        }
+    }
+
+    aclk_hz = sim_aclk_hz();
+    if (0u != aclk_hz && to >= sim_aclk_edge + SIM_PS_PER_S / aclk_hz)
+    {
+        sim_aclk_edge = to;
+
+        if (timer_captures_aclk(0u, 0u))
+        {
+            if (TIMER_REG(0u, TIMER_CCTL(0u)) & CCIFG)
+            {
+                TIMER_REG(0u, TIMER_CCTL(0u)) |= COV;
+            }
+
+            TIMER_REG(0u, TIMER_CCR(0u)) = TIMER_REG(0u, TIMER_R);
+            TIMER_REG(0u, TIMER_CCTL(0u)) |= CCIFG;
+        }
+    }
+}
+
+void sim_timer_clock_changed(void)
+{
+    uint32_t hz;
+    uint8_t t;
+
+    for (t = 0u; t < SIM_TIMER_COUNT; t++)
+    {
+        hz = timer_hz(t);
+
+        // El estado ya avanzó hasta sim_now. Con otra frecuencia, la siguiente cuenta ocurre un periodo después.
+        if (hz != sim_timers[t].hz)
+        {
+            sim_timers[t].hz = hz;
+            if (0u != hz)
+            {
+                sim_timers[t].period = SIM_PS_PER_S / hz;
+                sim_timers[t].next_count = sim_now + sim_timers[t].period;
+            }
+        }
+    }
+}
+
+void sim_timer_read_iv(sim_reg_e reg)
+{
+    uint8_t t = (SIM_REG_TA0IV == reg) ? 0u : 1u;
+    uint16_t iv = 0u;
+
+    // TAxIV indica la interrupción habilitada de mayor prioridad: CCR1, CCR2, desborde.
+    if ((TIMER_REG(t, TIMER_CCTL(1u)) & CCIE) && (TIMER_REG(t, TIMER_CCTL(1u)) & CCIFG))
+    {
+        TIMER_REG(t, TIMER_CCTL(1u)) &= ~CCIFG;
+        iv = TA0IV_TACCR1;
+    }
+    else if ((TIMER_REG(t, TIMER_CCTL(2u)) & CCIE) && (TIMER_REG(t, TIMER_CCTL(2u)) & CCIFG))
+    {
+        TIMER_REG(t, TIMER_CCTL(2u)) &= ~CCIFG;
+        iv = TA0IV_TACCR2;
+    }
+    else if ((TIMER_REG(t, TIMER_CTL) & TAIE) && (TIMER_REG(t, TIMER_CTL) & TAIFG))
+    {
+        TIMER_REG(t, TIMER_CTL) &= ~TAIFG;
+        iv = TA0IV_TAIFG;
+    }
+
+    TIMER_REG(t, TIMER_IV) = iv;
+}
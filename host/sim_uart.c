@@ -0,0 +1,231 @@
+/*
+ * sim_uart.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#define _XOPEN_SOURCE 600
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sim_private.h"
+
+#define SIM_UART_FRAME_BITS     (10u)   /* Inicio, 8 bits de datos, parada. */
+#define SIM_UART_FRAME_PARTS    (65536u)
+
+static int sim_uart_fd = STDOUT_FILENO;
+static uint8_t sim_uart_throttle = 1u;
+static uint8_t sim_uart_in_reset = 1u;
+
+/* Byte en UCA0TXBUF, esperando al registro de desplazamiento. */
+static uint8_t sim_uart_buffer;
+static uint8_t sim_uart_buffer_full;
+
+/*
+ * Byte en el registro de desplazamiento (UCBUSY) y tiempo en el que termina de salir. Sin clock (SMCLK apagado en
+ * LPM3), el byte se detiene: shift_left guarda la fracción del frame que falta, en SIM_UART_FRAME_PARTS.
+ */
+static uint8_t sim_uart_shift;
+static sim_ps_t sim_uart_shift_end = SIM_NEVER;
+static sim_ps_t sim_uart_shift_frame = SIM_NEVER;
+static uint32_t sim_uart_shift_left;
+
+static void uart_output(uint8_t byte)
+{
+    if (1 != write(sim_uart_fd, &byte, 1u))
+    {
+        sim_exit(EXIT_FAILURE, "no se pudo escribir la salida de la UART");
+    }
+}
+
+/* Tiempo de un byte al baud rate de UCA0BRx/UCA0MCTL con SMCLK. SIM_NEVER si la UART no tiene clock. */
+static sim_ps_t uart_frame_ps(void)
+{
+    uint32_t hz = sim_smclk_hz();
+    uint64_t divider_x16;
+    uint16_t br = (uint16_t) (SIM_R(SIM_REG_UCA0BR0) | (SIM_R(SIM_REG_UCA0BR1) << 8u));
+    uint8_t mctl = (uint8_t) SIM_R(SIM_REG_UCA0MCTL);
+
+    if (UCSSEL_2 != (SIM_R(SIM_REG_UCA0CTL1) & UCSSEL_3))
+    {
+        // Solo SMCLK está simulado como clock de la UART.
+        hz = (UCSSEL_1 == (SIM_R(SIM_REG_UCA0CTL1) & UCSSEL_3)) ? sim_aclk_hz() : 0u;
+    }
+
+    if (0u == hz || 0u == br)
+    {
+        return SIM_NEVER;
+    }
+
+    // Divisor en dieciseisavos: con UCOS16, 16 * UCBRx + UCBRFx; sin UCOS16, UCBRx + UCBRSx / 8.
+    if (mctl & UCOS16)
+    {
+        divider_x16 = (16uLL * br + ((mctl >> 4u) & 0x0Fu)) * 16uLL;
+    }
+    else
+    {
+        divider_x16 = 16uLL * br + 2uLL * ((mctl >> 1u) & 0x07u);
+    }
+
+    return (SIM_UART_FRAME_BITS * SIM_PS_PER_S / 16uLL) * divider_x16 / hz;
+}
+
+/*
+ * Pasa el byte de UCA0TXBUF al registro de desplazamiento en el tiempo start. UCA0TXIFG indica que UCA0TXBUF está
+ * libre.
+ */
+static void uart_start_shift(sim_ps_t start)
+{
+    sim_ps_t frame;
+
+    while (sim_uart_buffer_full)
+    {
+        sim_uart_buffer_full = 0u;
+        SIM_R(SIM_REG_IFG2) |= UCA0TXIFG;
+
+        frame = uart_frame_ps();
+
+        if (!sim_uart_throttle && SIM_NEVER != frame)
+        {
+            // Sin limitar el baud rate, el byte sale de inmediato.
+            uart_output(sim_uart_buffer);
+            continue;
+        }
+
+        sim_uart_shift = sim_uart_buffer;
+        sim_uart_shift_frame = frame;
+        sim_uart_shift_left = SIM_UART_FRAME_PARTS;
+        sim_uart_shift_end = (SIM_NEVER == frame) ? SIM_NEVER : start + frame;
+        SIM_R(SIM_REG_UCA0STAT) |= UCBUSY;
+        return;
+    }
+}
+
+void sim_uart_init(void)
+{
+    const char * env;
+
+    SIM_R(SIM_REG_UCA0CTL1) = UCSWRST;
+    SIM_R(SIM_REG_IFG2) = UCA0TXIFG;
+
+    env = getenv("SIM_UART_THROTTLE");
+    if (0 != env)
+    {
+        sim_uart_throttle = (0 != atoi(env));
+    }
+
+    env = getenv("SIM_UART");
+    if (0 != env && 0 != sim_uart_open(env, sim_uart_throttle))
+    {
+        sim_exit(EXIT_FAILURE, "no se pudo abrir SIM_UART");
+    }
+}
+
+int sim_uart_open(const char * path, uint8_t throttle)
+{
+    int fd;
+
+    if (0 == strcmp(path, "pty"))
+    {
+        fd = posix_openpt(O_RDWR | O_NOCTTY);
+        if (0 > fd || 0 != grantpt(fd) || 0 != unlockpt(fd))
+        {
+            return -1;
+        }
+
+        fprintf(stderr, "sim: UART en %s\n", ptsname(fd));
+    }
+    else
+    {
+        fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (0 > fd)
+        {
+            return -1;
+        }
+    }
+
+    sim_uart_fd = fd;
+    sim_uart_throttle = throttle;
+
+    return 0;
+}
+
+void sim_uart_commit(sim_reg_e reg)
+{
+    if (SIM_REG_UCA0CTL1 == reg)
+    {
+        if ((SIM_R(SIM_REG_UCA0CTL1) & UCSWRST) && !sim_uart_in_reset)
+        {
+            // UCSWRST descarta la transmisión, desactiva las interrupciones de la UART y deja UCA0TXIFG activo.
+            sim_uart_buffer_full = 0u;
+            sim_uart_shift_end = SIM_NEVER;
+            SIM_R(SIM_REG_UCA0STAT) &= ~UCBUSY;
+            SIM_R(SIM_REG_IE2) &= ~(UCA0TXIE | UCA0RXIE);
+            SIM_R(SIM_REG_IFG2) = (SIM_R(SIM_REG_IFG2) & ~UCA0RXIFG) | UCA0TXIFG;
+        }
+
+        sim_uart_in_reset = (SIM_R(SIM_REG_UCA0CTL1) & UCSWRST);
+    }
+    else if (SIM_REG_UCA0TXBUF == reg && !sim_uart_in_reset)
+    {
+        // UCA0TXBUF es de solo escritura: cada acceso es un byte nuevo.
+        sim_uart_buffer = (uint8_t) SIM_R(SIM_REG_UCA0TXBUF);
+        sim_uart_buffer_full = 1u;
+        SIM_R(SIM_REG_IFG2) &= ~UCA0TXIFG;
+
+        if (!(SIM_R(SIM_REG_UCA0STAT) & UCBUSY))
+        {
+            uart_start_shift(sim_now);
+        }
+    }
+}
+
+sim_ps_t sim_uart_next_event(void)
+{
+    return sim_uart_shift_end;
+}
+
+void sim_uart_clock_changed(void)
+{
+    sim_ps_t frame;
+
+    if (!(SIM_R(SIM_REG_UCA0STAT) & UCBUSY))
+    {
+        return;
+    }
+
+    frame = uart_frame_ps();
+    if (frame == sim_uart_shift_frame)
+    {
+        return;
+    }
+
+    // Lo que falta del byte se mide en fracciones del frame, para continuar con el clock nuevo.
+    if (SIM_NEVER != sim_uart_shift_end)
+    {
+        sim_uart_shift_left = (uint32_t) ((sim_uart_shift_end - sim_now) * SIM_UART_FRAME_PARTS / sim_uart_shift_frame);
+    }
+
+    sim_uart_shift_frame = frame;
+    sim_uart_shift_end = (SIM_NEVER == frame) ? SIM_NEVER : sim_now + frame * sim_uart_shift_left / SIM_UART_FRAME_PARTS;
+}
+
+void sim_uart_advance(sim_ps_t to)
+{
+    sim_ps_t end = sim_uart_shift_end;
+
+    if (to < end)
+    {
+        return;
+    }
+
+    uart_output(sim_uart_shift);
+    sim_uart_shift_end = SIM_NEVER;
+    SIM_R(SIM_REG_UCA0STAT) &= ~UCBUSY;
+
+    // sim_now todavía no llega a to: el siguiente byte comienza cuando termina el anterior.
+    uart_start_shift(end);
+}
@@ -0,0 +1,23 @@
+/*
+ * sim_vectors.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include "sim_private.h"
+
+/*
+ * Vectores de las ISRs del HAL, que en el MSP430 se instalan con #pragma vector. Las referencias son weak para que un
+ * programa que no usa un módulo del HAL no tenga que incluirlo. Las ISRs del kernel (OS_ISR en os/port.asm) pasan por
+ * os_isr_exit, entonces las instala el port del kernel con sim_vector_set y SIM_ISR_WAKE.
+ */
+extern void usciab_tx_isr(void) __attribute__((weak));
+
+__attribute__((constructor))
+static void sim_vectors_init(void)
+{
+    if (0 != usciab_tx_isr)
+    {
+        sim_vector_set(USCIAB0TX_VECTOR, usciab_tx_isr, 0u);
+    }
+}
@@ -0,0 +1,182 @@
+/*
+ * hal_test.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include <stdint.h>
+#include <stdio.h>
+
+#include "em.h"
+#include "hal_gpio.h"
+#include "hal_timer.h"
+#include "hal_uart.h"
+
+#include "sim.h"
+
+/*
+ * Prueba del HAL sobre el simulador (make -C host test). Cada resultado sale por la UART, y make compara esa salida y
+ * el registro de P1OUT (SIM_GPIO_TRACE) con los archivos esperados en host/tests. hal_test.script cambia BUTTON_PIN.
+ */
+
+#define GREEN_LED_PIN       ((uint8_t) 0x01u)
+#define BUTTON_PIN          ((uint8_t) 0x08u)
+#define RED_LED_PIN         ((uint8_t) 0x40u)
+
+/* Tiempos de hal_test.script, en us. */
+#define BUTTON_PRESS_US     (20000u)
+#define BUTTON_RELEASE_US   (40000u)
+
+/* hal_timer_delay también cuenta los accesos a los registros de su ciclo: unos ciclos de MCLK por milisegundo. */
+#define DELAY_TOLERANCE_US  (100u)
+
+#define UART_FRAME_BITS     (10u)
+
+static uint8_t failures;
+
+static void uart_wait_idle(void)
+{
+    while ((IE2 & UCA0TXIE) || (UCA0STAT & UCBUSY));
+}
+
+static void test_report(const char * name, uint8_t passed)
+{
+    static uint8_t line[48];
+    uint8_t len = 0u;
+    const char * text = passed ? "PASS " : "FAIL ";
+
+    while ('\0' != *text)
+    {
+        line[len++] = (uint8_t) *text++;
+    }
+
+    while ('\0' != *name && (sizeof(line) - 2u) > len)
+    {
+        line[len++] = (uint8_t) *name++;
+    }
+
+    line[len++] = '\r';
+    line[len++] = '\n';
+
+    // Con el buffer de transmisión vacío, la línea completa cabe.
+    uart_wait_idle();
+    hal_uart_send(line, len);
+
+    if (!passed)
+    {
+        failures++;
+    }
+}
+
+static void wait_until_us(uint64_t us)
+{
+    while (sim_time_us() < us)
+    {
+        hal_timer_delay(1u);
+    }
+}
+
+static uint8_t delay_takes(uint16_t milliseconds)
+{
+    uint64_t start = sim_time_us();
+    uint64_t elapsed;
+
+    hal_timer_delay(milliseconds);
+    elapsed = sim_time_us() - start;
+
+    if (elapsed < milliseconds * 1000uLL || elapsed > milliseconds * 1000uLL + DELAY_TOLERANCE_US)
+    {
+        fprintf(stderr, "hal_timer_delay(%u) tardó %llu us\n", milliseconds, (unsigned long long) elapsed);
+        return 0u;
+    }
+
+    return 1u;
+}
+
+static void test_timer(void)
+{
+    test_report("timer delay 8 MHz", delay_takes(10u));
+
+    // Con otra frecuencia de SMCLK, hal_timer_set_clock mantiene el milisegundo de hal_timer_delay.
+    uart_wait_idle();
+    DCO_CAL_1MHZ();
+    hal_timer_set_clock(1000000uL);
+    hal_uart_set_clock(1000000uL);
+
+    test_report("timer delay 1 MHz", delay_takes(10u));
+
+    uart_wait_idle();
+    DCO_CAL_8MHZ();
+    hal_timer_set_clock(HAL_TIMER_CLOCK_HZ);
+    hal_uart_set_clock(UART_CLOCK_HZ);
+}
+
+static void test_gpio(void)
+{
+    hal_gpio_set(GPIO_PORT_1, GREEN_LED_PIN);
+    hal_gpio_toggle(GPIO_PORT_1, GREEN_LED_PIN | RED_LED_PIN);
+    test_report("gpio output", RED_LED_PIN == hal_gpio_read(GPIO_PORT_1, GREEN_LED_PIN | RED_LED_PIN));
+    hal_gpio_reset(GPIO_PORT_1, RED_LED_PIN);
+
+    test_report("gpio input idle", 0u != hal_gpio_read(GPIO_PORT_1, BUTTON_PIN));
+
+    wait_until_us(BUTTON_PRESS_US + 1000u);
+    test_report("gpio input pressed", 0u == hal_gpio_read(GPIO_PORT_1, BUTTON_PIN));
+
+    wait_until_us(BUTTON_RELEASE_US + 1000u);
+    test_report("gpio input released", 0u != hal_gpio_read(GPIO_PORT_1, BUTTON_PIN));
+}
+
+static void test_uart(void)
+{
+    static uint8_t burst[UART_SEND_MAX_LEN + 8u];
+    uint64_t start;
+    uint64_t elapsed;
+    uint64_t expected;
+    uint8_t sent;
+    uint8_t i;
+
+    for (i = 0u; i < sizeof(burst); i++)
+    {
+        burst[i] = '-';
+    }
+    burst[UART_SEND_MAX_LEN - 2u] = '\r';
+    burst[UART_SEND_MAX_LEN - 1u] = '\n';
+
+    uart_wait_idle();
+
+    // La UART descarta lo que no cabe en el buffer de transmisión, y el tiempo de transmisión depende del baud rate.
+    start = sim_time_us();
+    sent = hal_uart_send(burst, (uint8_t) sizeof(burst));
+    uart_wait_idle();
+    elapsed = sim_time_us() - start;
+
+    expected = (uint64_t) sent * UART_FRAME_BITS * 1000000uLL / UART_BAUD_RATE;
+
+    test_report("uart buffer full", UART_SEND_MAX_LEN == sent);
+    test_report("uart baud rate", elapsed >= expected && elapsed <= expected + expected / 50u);
+}
+
+int main(void)
+{
+    WATCHDOG_STOP;
+    DCO_CAL_8MHZ();
+
+    HAL_TIMER_INIT(0);
+
+    hal_gpio_init(GPIO_PORT_1, (GREEN_LED_PIN | RED_LED_PIN), GPIO_DIRECTION_OUTPUT);
+    hal_gpio_init(GPIO_PORT_1, BUTTON_PIN, 0u);
+
+    hal_uart_init();
+
+    EM_GLOBAL_INTERRUPT_EN;
+
+    test_gpio();
+    test_timer();
+    test_uart();
+
+    test_report("hal_test", 0u == failures);
+    uart_wait_idle();
+
+    return (0u == failures) ? 0 : 1;
+}
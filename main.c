@@ -15,6 +15,7 @@
 #include "os/tasks.h"
 #include "os/alarms.h"
 #include "os/queues.h"
+#include "os/idle.h"
 
 #define FALSE       ((uint8_t) 0u)
 #define TRUE        ((uint8_t) 1u)
@@ -23,7 +24,8 @@
 #define GREEN_LED_PIN       ((uint8_t) 0x01u)
 #define RED_LED_PIN         ((uint8_t) 0x40u)
 
-/* OS tasks */
+/* OS tasks. Con OS_STATIC_CONFIG, las tareas, alarmas y queues están en app.oil y sus IDs en os_gen_cfg.h. */
+#ifndef OS_STATIC_CONFIG
 #define PRODUCER_TASK_ID    ((uint8_t) 0u)
 #define CONSUMER_TASK_ID    ((uint8_t) 1u)
 #define ANOTHER_TASK_ID     ((uint8_t) 2u)
@@ -34,11 +36,13 @@
 
 #define INITIAL_PRODUCER_DELAY_TICKS    ((tick_type_t) 100u)
 #define ANOTHER_TASK_DELAY_TICKS        ((tick_type_t) 5000u)
+#endif /* OS_STATIC_CONFIG */
 
-static void producer_task(void);
-static void consumer_task(void);
-static void another_task(void);
-static void idle_task(void);
+// Las tablas generadas (os_gen_cfg.c) hacen referencia a las tareas, entonces no pueden ser static.
+void producer_task(void);
+void consumer_task(void);
+void another_task(void);
+void idle_task(void);
 
 int main(void)
 {
@@ -57,9 +61,10 @@ int main(void)
     EM_GLOBAL_INTERRUPT_EN;
 
     // OS init.
+#ifndef OS_STATIC_CONFIG
 	os_task_create(PRODUCER_TASK_ID, producer_task, 3u, FALSE);
 	os_task_create(CONSUMER_TASK_ID, consumer_task, 3u, TRUE);
-	os_task_create(ANOTHER_TASK_ID, another_task, 4u, FALSE);
+	os_task_create_basic(ANOTHER_TASK_ID, another_task, 4u, FALSE);
 
     os_task_create(IDLE_TASK_ID, idle_task, 0u, TRUE);
 
@@ -69,6 +74,7 @@ int main(void)
     // Delays iniciales para probar queues.
     os_alarm_set_rel(ALARM_A, INITIAL_PRODUCER_DELAY_TICKS, PRODUCER_TASK_ID, FALSE);
     os_alarm_set_rel(ALARM_B, ANOTHER_TASK_DELAY_TICKS, ANOTHER_TASK_ID, FALSE);
+#endif /* OS_STATIC_CONFIG */
 
 	os_init();
 
@@ -130,7 +136,7 @@ void consumer_task(void)
     static uint8_t count;
     static uint8_t rx_success_msg[] = {'R', 'P', ' ', '_', '\r', '\n'};
 
-    // Primer receive falla si producer_task no enva algo inmediatamente.
+    // Primer receive falla si producer_task no envía algo inmediatamente.
     // ticks_to_wait es 0, entonces consumer_task no pasa a estado WAIT.
     status = os_queue_receive(TEST_QUEUE_ID, (void *) &item, (tick_type_t) 0u);
 
@@ -145,9 +151,9 @@ void consumer_task(void)
         hal_uart_send("RF, EMPTY\r\n", 11u);
     }
 
-    // consumer_task espera indeterminadamente a que producer_task enve algo en la queue.
+    // consumer_task espera indeterminadamente a que producer_task envíe algo en la queue.
     status = os_queue_receive(TEST_QUEUE_ID, (void *) &item, OS_MAX_TICKS);
-    // Si la tarea llega a este hal_uart_send(), significa que recibi un elemento de la queue.
+    // Si la tarea llega a este hal_uart_send(), significa que recibió un elemento de la queue.
     rx_success_msg[3] = *item;
     hal_uart_send(rx_success_msg, 6u);
     rx_success_msg[3] = '0';
@@ -198,6 +204,10 @@ void idle_task(void)
 {
     while (1)
     {
+#ifdef OS_LOW_POWER_IDLE
+        os_idle();
+#else
         EM_SLEEP_ENTER;
+#endif /* OS_LOW_POWER_IDLE */
     }
 }
@@ -7,45 +7,109 @@
 #include <msp430.h>
 
 #include "alarms.h"
+#include "tasks.h"
+#include "systime.h"
+#include "critical.h"
+#include "profiler.h"
 
 #include "os_private.h"
 
-#ifdef SYSTICK_BASE_TA0_0
-#define SYSTICK_VECTOR  TIMER0_A0_VECTOR
-#define SYSTICK_CCR     TA0CCR0
-#endif /* SYSTICK_BASE_TA0_0 */
-
-#define ALARM_AUTORELOAD    (0x01u)
 #define ALARM_ACTIVE        (0x02u)
+#define ALARM_CALLBACK      (0x04u)     /* La alarma ejecuta un callback en vez de activar una tarea. */
+#define ALARM_PENDING       (0x08u)     /* La alarma expiró y su callback no se ha ejecutado. */
+
+#ifdef OS_STATIC_CONFIG
+#define ALARM_TASK(id)      (os_alarm_config[(id)].task_to_activate)
+#define ALARM_CALLBACK_FN(id)   (os_alarm_config[(id)].callback)
+#else
+#define ALARM_TASK(id)      (alarms[(id)].task_to_activate)
+#define ALARM_CALLBACK_FN(id)   (alarms[(id)].callback)
+#endif /* OS_STATIC_CONFIG */
 
 typedef struct _alarm_t {
-    uint16_t ticks;
-    uint16_t count;
+    os_time_t expiry;                   /* Tiempo del sistema de la siguiente expiración. */
+    os_time_t cycle;                    /* Ticks entre expiraciones. Es 0 si la alarma es de activación única. */
+#ifndef OS_STATIC_CONFIG
     uint8_t task_to_activate;
+#ifdef OS_TIMER_SERVICE
+    os_alarm_callback_t callback;
+#endif /* OS_TIMER_SERVICE */
+#endif /* OS_STATIC_CONFIG */
     uint8_t state;
 } alarm_t;
 
 static volatile alarm_t alarms[ALARM_MAX];
 
+#ifdef OS_TIMER_SERVICE
+/* Distinto de 0 si alguna alarma con callback expiró en el tick actual. */
+static volatile uint8_t timer_service_pending;
+#endif /* OS_TIMER_SERVICE */
+
+static void alarm_start(alarm_id_e id, os_time_t expiry, os_time_t cycle, task_id_t task_to_activate, uint8_t state);
+static uint8_t alarms_tick(void);
+
+#ifdef OS_STATIC_CONFIG
+void alarms_init(void)
+{
+    uint8_t i;
+
+    i = ALARM_MAX;
+    while (i--)
+    {
+        if (os_alarm_config[i].autostart)
+        {
+            alarms[i] = (alarm_t) {
+                .expiry = os_tick_count + os_alarm_config[i].alarm_time,
+                .cycle = os_alarm_config[i].cycle_time,
+                .state = ALARM_ACTIVE,
+            };
+
+#ifdef OS_TIMER_SERVICE
+            if (0 != os_alarm_config[i].callback)
+            {
+                alarms[i].state |= ALARM_CALLBACK;
+            }
+#endif /* OS_TIMER_SERVICE */
+        }
+    }
+}
+#endif /* OS_STATIC_CONFIG */
+
 error_id_e os_alarm_set_rel(alarm_id_e id, uint16_t ticks, task_id_t task_to_activate, uint8_t autoreload)
 {
-    if (ALARM_MAX <= id || 0 == ticks || NUM_TASK_MAX < task_to_activate)
+    if (ALARM_MAX <= id || 0 == ticks || NUM_TASK_MAX <= task_to_activate)
     {
         return OS_ERROR_INVALID_ARGUMENT;
     }
 
-    alarms[id] = (alarm_t) {
-        .ticks = ticks,
-        .count = ticks,
-        .task_to_activate = task_to_activate,
-        .state = ALARM_ACTIVE,
-    };
+#ifdef OS_STATIC_CONFIG
+    if (os_alarm_config[id].task_to_activate != task_to_activate)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+#endif /* OS_STATIC_CONFIG */
+
+    alarm_start(id, os_time_get() + ticks, autoreload ? ticks : 0u, task_to_activate, ALARM_ACTIVE);
 
-    if (autoreload)
+    return OS_OK;
+}
+
+error_id_e os_alarm_set_abs(alarm_id_e id, os_time_t start, os_time_t cycle, task_id_t task_to_activate)
+{
+    if (ALARM_MAX <= id || NUM_TASK_MAX <= task_to_activate || 0x7FFFFFFFu < cycle)
     {
-        alarms[id].state |= ALARM_AUTORELOAD;
+        return OS_ERROR_INVALID_ARGUMENT;
     }
 
+#ifdef OS_STATIC_CONFIG
+    if (os_alarm_config[id].task_to_activate != task_to_activate)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+#endif /* OS_STATIC_CONFIG */
+
+    alarm_start(id, start, cycle, task_to_activate, ALARM_ACTIVE);
+
     return OS_OK;
 }
 
@@ -56,41 +120,199 @@ error_id_e os_alarm_cancel(alarm_id_e id)
         return OS_ERROR_INVALID_ARGUMENT;
     }
 
-    alarms[id].state &= ~ALARM_ACTIVE;
+    alarms[id].state &= ~(ALARM_ACTIVE | ALARM_PENDING);
+
+    return OS_OK;
+}
+
+static void alarm_start(alarm_id_e id, os_time_t expiry, os_time_t cycle, task_id_t task_to_activate, uint8_t state)
+{
+    // systick_isr lee expiry y cycle, que no se pueden escribir en una sola instrucción.
+    os_enter_tick_critical();
+
+    alarms[id].state = 0u;
+    alarms[id].expiry = expiry;
+    alarms[id].cycle = cycle;
+#ifndef OS_STATIC_CONFIG
+    alarms[id].task_to_activate = task_to_activate;
+#endif /* OS_STATIC_CONFIG */
+    alarms[id].state = state;
+
+    os_exit_tick_critical();
+}
+
+#ifdef OS_TIMER_SERVICE
+error_id_e os_alarm_set_callback(alarm_id_e id, uint16_t ticks, os_alarm_callback_t callback, uint8_t autoreload)
+{
+    if (ALARM_MAX <= id || 0 == ticks || 0 == callback)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+
+#ifdef OS_STATIC_CONFIG
+    if (os_alarm_config[id].callback != callback)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+#else
+    alarms[id].state = 0u;
+    alarms[id].callback = callback;
+#endif /* OS_STATIC_CONFIG */
+
+    alarm_start(id, os_time_get() + ticks, autoreload ? ticks : 0u, OS_TASK_ID_MAX, ALARM_ACTIVE | ALARM_CALLBACK);
 
     return OS_OK;
 }
 
-#pragma vector=SYSTICK_VECTOR
-__interrupt void systick_isr(void)
+void os_timer_service_task(void)
 {
-    volatile uint16_t i = ALARM_MAX;
-    volatile uint8_t task_activated = 0;
+    uint8_t i;
+    os_alarm_callback_t callback;
 
-    SYSTICK_CCR += SYSTICK_PERIOD;
+#ifdef OS_DEFERRED_CALLS
+    deferred_calls_run();
+#endif /* OS_DEFERRED_CALLS */
 
+    i = ALARM_MAX;
     while (i--)
     {
-        if (ALARM_ACTIVE & alarms[i].state && 0u == (--alarms[i].count))
+        callback = 0;
+
+        os_enter_tick_critical();
+        if (ALARM_PENDING & alarms[i].state)
         {
-            if (OS_TASK_STATE_EMPTY != tasks[alarms[i].task_to_activate].state)
-            {
-                tasks[alarms[i].task_to_activate].state = OS_TASK_STATE_READY;
-                num_active_tasks++;
-            }
+            alarms[i].state &= ~ALARM_PENDING;
+            callback = ALARM_CALLBACK_FN(i);
+        }
+        os_exit_tick_critical();
 
-            if (ALARM_AUTORELOAD & alarms[i].state)
-            {
-                alarms[i].count = alarms[i].ticks;
-            }
-            else
-            {
-                alarms[i].state &= ~ALARM_ACTIVE;
-            }
+        if (0 != callback)
+        {
+            callback();
+        }
+    }
 
-            task_activated = 1;
+    os_task_terminate();
+}
+
+uint8_t timer_service_activate(void)
+{
+    // Basta con una activación registrada: cuando se ejecuta, la tarea de servicio revisa todas las alarmas.
+    if (1u < tasks[OS_TIMER_SERVICE_TASK_ID].activations)
+    {
+        return 0u;
+    }
+
+    return (OS_OK == task_activate(OS_TIMER_SERVICE_TASK_ID));
+}
+#endif /* OS_TIMER_SERVICE */
+
+static uint8_t alarms_tick(void)
+{
+    uint8_t task_activated = 0u;
+    uint8_t i;
+
+    os_tick_count++;
+
+    i = ALARM_MAX;
+    while (i--)
+    {
+        // Una alarma con expiry en el pasado (por ejemplo, una alarma absoluta iniciada tarde) expira en este tick.
+        if (0u == (ALARM_ACTIVE & alarms[i].state) || OS_TIME_BEFORE(os_tick_count, alarms[i].expiry))
+        {
+            continue;
+        }
+
+#ifdef OS_TIMER_SERVICE
+        if (ALARM_CALLBACK & alarms[i].state)
+        {
+            // El callback se ejecuta en la tarea de servicio, para que la ISR sea corta.
+            alarms[i].state |= ALARM_PENDING;
+            timer_service_pending = 1u;
+        }
+        else
+#endif /* OS_TIMER_SERVICE */
+        {
+            task_activate(ALARM_TASK(i));
+            task_activated = 1u;
         }
+
+        if (0u != alarms[i].cycle)
+        {
+            // La siguiente expiración se calcula desde la expiración programada, no desde el tick actual, para que las
+            // alarmas periódicas no acumulen retraso.
+            alarms[i].expiry += alarms[i].cycle;
+        }
+        else
+        {
+            alarms[i].state &= ~ALARM_ACTIVE;
+        }
+    }
+
+#ifdef OS_TIMER_SERVICE
+    if (timer_service_pending)
+    {
+        timer_service_pending = 0u;
+        task_activated |= timer_service_activate();
     }
+#endif /* OS_TIMER_SERVICE */
+
+    return task_activated;
+}
+
+#ifdef OS_LOW_POWER_IDLE
+void alarms_next_event(tick_type_t * next)
+{
+    int32_t ticks;
+    uint8_t i;
+
+    i = ALARM_MAX;
+    while (i--)
+    {
+        if (0u == (ALARM_ACTIVE & alarms[i].state))
+        {
+            continue;
+        }
+
+        // alarms_tick incrementa os_tick_count antes de comparar. Una alarma con expiry en el pasado expira en el
+        // siguiente tick.
+        ticks = (int32_t) (alarms[i].expiry - os_tick_count);
+        if (1 > ticks)
+        {
+            ticks = 1;
+        }
+        else if ((int32_t) OS_MAX_TICKS < ticks)
+        {
+            ticks = (int32_t) OS_MAX_TICKS;
+        }
+
+        OS_NEXT_EVENT(*next, (tick_type_t) ticks);
+    }
+}
+#endif /* OS_LOW_POWER_IDLE */
+
+/*
+ * Handler de la interrupción de systick. No es una ISR: el vector apunta a la entrada que declara OS_ISR en
+ * os/port.asm, que llama a esta función y regresa a través de os_isr_exit.
+ */
+void systick_handler(void)
+{
+    task_id_t i;
+    uint8_t task_activated = 0u;
+
+#ifdef OS_IDLE_TICKLESS
+    if (idle_tickless)
+    {
+        // El timer cuenta con ACLK y el CPU está en LPM3 (ver os_idle). os_idle procesa los ticks al despertar.
+        return;
+    }
+#endif /* OS_IDLE_TICKLESS */
+
+    PROFILER_START(OS_PROFILER_KIND_IRQ);
+
+    SYSTICK_CCR += SYSTICK_PERIOD_NOW;
+
+    task_activated |= alarms_tick();
 
     i = NUM_TASK_MAX;
     while (i--)
@@ -98,34 +320,40 @@ __interrupt void systick_isr(void)
         if (OS_TASK_STATE_WAIT == tasks[i].state && 0u == (--tasks[i].ticks_to_wait))
         {
             tasks[i].state = OS_TASK_STATE_READY;
-            task_activated = 1;
+            task_activated = 1u;
         }
     }
 
+#ifdef OS_SCHEDULE_TABLES
+    task_activated |= schedtable_tick();
+#endif /* OS_SCHEDULE_TABLES */
+
+#ifdef OS_SCHEDULER_EDF
+    task_activated |= scheduler_edf_tick();
+#endif /* OS_SCHEDULER_EDF */
+
+#ifdef OS_ROUND_ROBIN
+    task_activated |= scheduler_rr_tick();
+#endif /* OS_ROUND_ROBIN */
+
+#ifdef OS_GPIO_IRQ
+    // Los handlers de los pines marcan os_switch_pending si activan una tarea.
+    gpio_irq_tick();
+#endif /* OS_GPIO_IRQ */
+
+#ifdef OS_SUPERVISOR
+    supervisor_tick();
+#endif /* OS_SUPERVISOR */
+
+#ifdef OS_DVFS
+    dvfs_tick();
+#endif /* OS_DVFS */
+
     if (task_activated)
     {
-        if (OS_TASK_ID_MAX != current_task)
-        {
-            tasks[current_task].state = OS_TASK_STATE_READY;
-        }
-
-        // Descartar espacio de stack usado por variables locales i y task_activated.
-        __asm volatile (" ADD #4, SP");
-        // Recuperar valores originales de R11 -> R15 desde el stack (la ISR los mueve cuando inicia).
-        __asm volatile (" POP R10");
-        __asm volatile (" POP R11");
-        __asm volatile (" POP R12");
-        __asm volatile (" POP R13");
-        __asm volatile (" POP R14");
-        __asm volatile (" POP R15");
-        // Desactivar interrupciones en SR guardado y luego sacarlo del stack.
-        __asm volatile (" BIC #0x00F8, 0(SP)");
-        __asm volatile (" POP SR");
-
-        /*TODO: Encontrar forma de que etiqueta scheduler_run est disponible fuera de os_private. */
-//        scheduler_run();
-//        __asm volatile (" BR #scheduler_run");
-        __asm volatile (" BR #0xC408");
+        os_switch_pending = 1u;
     }
+
+    PROFILER_STOP(OS_PROFILER_KIND_IRQ);
 }
 
@@ -11,7 +11,14 @@
 #include <stdint.h>
 
 #include "os.h"
+#include "systime.h"
 
+#ifdef OS_STATIC_CONFIG
+/* Los identificadores de las alarmas (*_ALARM_ID) están en os_gen_cfg.h. */
+typedef uint8_t alarm_id_e;
+
+#define ALARM_MAX   OS_ALARM_COUNT
+#else
 typedef enum _alarm_id_e {
     ALARM_A,
     ALARM_B,
@@ -21,30 +28,85 @@ typedef enum _alarm_id_e {
     ALARM_F,
     ALARM_MAX,
 } alarm_id_e;
+#endif /* OS_STATIC_CONFIG */
+
+typedef void (*os_alarm_callback_t)(void);
 
 /**
  * @brief Activa una alarma relativa. Cuando la alarma relativa expira, el OS activa la tarea especificada.
  *
- * La alarma puede ser de activacin nica ("one-shot") o de activacin mltiple ("auto-reload").
+ * La alarma puede ser de activación única ("one-shot") o de activación múltiple ("auto-reload").
  *
- * @param id Identificador nico de la alarma que ser activada.
- * @param ticks Nmero de ticks para que expire la alarma, relativos al tick actual.
- * @param task_to_activate Identificador nico de la tarea que ser activada cuando la alarma expire.
+ * @param id Identificador único de la alarma que será activada.
+ * @param ticks Número de ticks para que expire la alarma, relativos al tick actual.
+ * @param task_to_activate Identificador único de la tarea que será activada cuando la alarma expire.
  * @param autoreload Si es distinto de 0, el OS recarga la cuenta de la alarma y la vuelve a iniciar.
  *
- * @return OS_OK si el OS activ la alarma.
- *         OS_ERROR_INVALID_ARGUMENT si id, ticks o task_to_activate tienen valores invlidos.
+ * Con OS_STATIC_CONFIG, la tarea de cada alarma está definida en app.oil y task_to_activate debe ser esa tarea.
+ *
+ * @return OS_OK si el OS activó la alarma.
+ *         OS_ERROR_INVALID_ARGUMENT si id, ticks o task_to_activate tienen valores inválidos.
  */
 error_id_e os_alarm_set_rel(alarm_id_e id, uint16_t ticks, uint8_t task_to_activate, uint8_t autoreload);
 
+/**
+ * @brief Activa una alarma absoluta. La alarma expira cuando el tiempo del sistema (os_time_get) llega a start, y
+ * después cada cycle ticks.
+ *
+ * Cada expiración se calcula desde la anterior, entonces una alarma absoluta periódica no acumula retraso aunque la
+ * tarea que la activa se ejecute tarde. Si start ya pasó, la alarma expira en el siguiente tick; si también ya pasaron
+ * las siguientes expiraciones, expira una vez por tick hasta alcanzar el tiempo actual.
+ *
+ * @param id Identificador único de la alarma que será activada.
+ * @param start Tiempo del sistema de la primera expiración.
+ * @param cycle Ticks entre expiraciones, hasta 2^31 - 1. Es 0 para una alarma de activación única.
+ * @param task_to_activate Identificador único de la tarea que será activada cuando la alarma expire.
+ *
+ * @return OS_OK si el OS activó la alarma.
+ *         OS_ERROR_INVALID_ARGUMENT si id, cycle o task_to_activate tienen valores inválidos.
+ */
+error_id_e os_alarm_set_abs(alarm_id_e id, os_time_t start, os_time_t cycle, uint8_t task_to_activate);
+
 /**
  * @brief Cancela una alarma, evitando que expire y active una tarea.
  *
- * @param id Identificador nico de la alarma que ser cancelada.
+ * @param id Identificador único de la alarma que será cancelada.
  *
- * @return OS_OK si el OS cancel la alarma.
+ * @return OS_OK si el OS canceló la alarma.
  *         OS_ERROR_INVALID_ARGUMENT si id no es alguno de ALARM_*.
  */
 error_id_e os_alarm_cancel(alarm_id_e id);
 
+#ifdef OS_TIMER_SERVICE
+/**
+ * @brief Activa una alarma relativa con callback. Cuando la alarma expira, la tarea de servicio de timers ejecuta
+ * callback.
+ *
+ * callback se ejecuta en el contexto de os_timer_service_task, no en systick_isr: debe ser corto y no puede esperar.
+ * Si la alarma expira varias veces antes de que la tarea de servicio se ejecute, callback se ejecuta una sola vez.
+ *
+ * Con OS_STATIC_CONFIG, el callback de cada alarma está definido en app.oil y callback debe ser esa función.
+ *
+ * @param id Identificador único de la alarma que será activada.
+ * @param ticks Número de ticks para que expire la alarma, relativos al tick actual.
+ * @param callback Función que se ejecuta cuando la alarma expira.
+ * @param autoreload Si es distinto de 0, el OS recarga la cuenta de la alarma y la vuelve a iniciar.
+ *
+ * @return OS_OK si el OS activó la alarma.
+ *         OS_ERROR_INVALID_ARGUMENT si id, ticks o callback tienen valores inválidos.
+ */
+error_id_e os_alarm_set_callback(alarm_id_e id, uint16_t ticks, os_alarm_callback_t callback, uint8_t autoreload);
+
+/**
+ * @brief Tarea de servicio de timers. Ejecuta, en lote, los callbacks de todas las alarmas que expiraron desde su
+ * última ejecución.
+ *
+ * La aplicación debe crear esta tarea como tarea básica con el ID OS_TIMER_SERVICE_TASK_ID, y normalmente con una
+ * prioridad mayor que el resto de las tareas:
+ *
+ *     os_task_create_basic(OS_TIMER_SERVICE_TASK_ID, os_timer_service_task, 10u, FALSE);
+ */
+void os_timer_service_task(void);
+#endif /* OS_TIMER_SERVICE */
+
 #endif /* OS_INCLUDE_ALARMS_H_ */
@@ -8,21 +8,61 @@
 #define OS_CONFIG_H_
 
 /*
- * Nmero mximo de tareas que puede ejecutar el sistema operativo. Usar os_task_create cuando ya hay este
- * nmero de tareas ejecutndose resulta en un error.
+ * Usar la configuración estática generada por tools/osgen.py a partir de app.oil. Las tareas, alarmas y queues se
+ * definen en tablas const (flash), y el número de tareas, tareas extendidas, alarmas y queues viene de os_gen_cfg.h.
+ * Con la configuración estática no existen os_task_create* ni os_queue_init.
  */
+//#define OS_STATIC_CONFIG    (1)
+
+#ifdef OS_STATIC_CONFIG
+#include "os_gen_cfg.h"
+#endif /* OS_STATIC_CONFIG */
+
+/*
+ * Número máximo de tareas que puede ejecutar el sistema operativo. Usar os_task_create cuando ya hay este
+ * número de tareas ejecutándose resulta en un error.
+ */
+#ifndef OS_STATIC_CONFIG
 #define NUM_TASK_MAX    ((uint8_t) 4u)
+#endif /* OS_STATIC_CONFIG */
 
 /*
- * ID numrico mximo para una tarea.
+ * ID numérico máximo para una tarea.
  */
 #define OS_TASK_ID_MAX  ((uint8_t) 0xFFu)
 
 /*
- * Tamao en palabras del stack dedicado para una tarea. Debe ser al menos de 16 palabras (32 bytes) para almacenar
- * los 16 registros en los cambios de contexto.
+ * Número máximo de tareas extendidas (creadas con os_task_create). Solo las tareas extendidas tienen stack y bloque de
+ * contexto propios. Las tareas básicas (os_task_create_basic) se ejecutan hasta terminar, anidadas sobre el stack del
+ * contexto que las despacha.
  */
-#define TASK_STACK_SIZE ((uint8_t) 16u)
+#ifndef OS_STATIC_CONFIG
+#define OS_EXTENDED_TASK_COUNT  ((uint8_t) 3u)
+#endif /* OS_STATIC_CONFIG */
+
+/*
+ * Stacks de las tareas extendidas. El stack de la tarea extendida número k (en orden de creación) inicia en
+ * OS_TASK_STACK_TOP - k * OS_TASK_STACK_BYTES. Cada stack debe tener espacio para las tareas básicas e ISRs que
+ * pueden ejecutarse anidadas sobre la tarea. De cada stack, TASK_STACK_KERNEL_BYTES (48, os_private.h) son para el
+ * kernel mientras una ISR desplaza a la tarea; el resto es el presupuesto de la tarea.
+ */
+#define OS_TASK_STACK_TOP       (0x03FEu)
+#define OS_TASK_STACK_BYTES     (72u)
+
+/*
+ * Número máximo de activaciones que puede registrar una tarea, incluyendo la activación en curso. Activar una tarea
+ * que ya está activa registra la activación, y la tarea vuelve a ejecutarse cuando termina (os_task_terminate).
+ */
+#define OS_TASK_ACTIVATIONS_MAX ((uint8_t) 2u)
+
+/* Llamar a os_activation_overflow_hook() cuando una activación se pierde porque la tarea llegó a OS_TASK_ACTIVATIONS_MAX. */
+//#define OS_ACTIVATION_OVERFLOW_HOOK (1)
+
+/*
+ * Tamaño en palabras del contexto de una tarea extendida. port_context_switch solo guarda los registros que preserva
+ * una llamada a función (R4-R10), SR, SP y PC, entonces debe ser al menos de 10 palabras.
+ */
+#define TASK_STACK_SIZE ((uint8_t) 10u)
 
 /* Timer de hardware usado como base para systick. */
 #define SYSTICK_BASE_TA0_0  (1)
@@ -32,20 +72,205 @@
 //#define SYSTICK_BASE_TA1_1  (1)
 //#define SYSTICK_BASE_TA1_2  (1)
 
-/* Nmero de cuentas del timer base por cada tick (segundos por tick / clock Hz). */
+/* Número de cuentas del timer base por cada tick (segundos por tick / clock Hz). */
 #define SYSTICK_PERIOD      (8000u)
 
+/* Frecuencia del clock del timer base (SMCLK), en Hz. Debe ser un múltiplo de 1 MHz para convertir timestamps a us. */
+#define SYSTICK_CLOCK_HZ    (8000000uL)
+
+/*
+ * Habilitar round-robin entre tareas de igual prioridad. Sin round-robin, entre varias tareas listas con la misma
+ * prioridad siempre gana la de menor ID.
+ */
+//#define OS_ROUND_ROBIN      (1)
+
+/* Ticks que puede ejecutarse una tarea antes de ceder el CPU a otra tarea lista con su misma prioridad. */
+#ifdef OS_ROUND_ROBIN
+#define OS_RR_TIME_SLICE_TICKS  (10u)
+#endif /* OS_ROUND_ROBIN */
+
+/*
+ * Usar EDF (earliest deadline first) en vez de prioridades fijas. El scheduler elige la tarea lista con el deadline
+ * absoluto más cercano. Las tareas no periódicas (creadas con os_task_create) no tienen deadline, y solo se ejecutan
+ * cuando no hay tareas periódicas listas.
+ */
+//#define OS_SCHEDULER_EDF    (1)
+
+/* Llamar a os_deadline_miss_hook() cada vez que una tarea periódica no termina antes de su deadline. */
+#ifdef OS_SCHEDULER_EDF
+//#define OS_DEADLINE_MISS_HOOK   (1)
+#endif /* OS_SCHEDULER_EDF */
+
+/*
+ * Habilitar umbrales de desplazamiento (preemption thresholds). Una tarea que comenzó a ejecutarse solo puede ser
+ * desplazada por tareas con prioridad mayor que su umbral, entonces las tareas de un grupo con el mismo umbral no se
+ * desplazan entre sí. No aplica con OS_SCHEDULER_EDF.
+ */
+#ifndef OS_SCHEDULER_EDF
+//#define OS_PREEMPTION_THRESHOLD (1)
+#endif /* OS_SCHEDULER_EDF */
+
+/*
+ * Habilitar tablas de activación (schedule tables). La aplicación define las tablas en flash, en el arreglo
+ * os_schedtables (ver schedtables.h).
+ */
+//#define OS_SCHEDULE_TABLES  (1)
+
+/* Número de tablas de activación definidas en os_schedtables. */
+#ifdef OS_SCHEDULE_TABLES
+#define OS_SCHEDTABLE_COUNT (1)
+#endif /* OS_SCHEDULE_TABLES */
+
+/*
+ * Habilitar alarmas con callback. En vez de activar una tarea, la alarma ejecuta una función en la tarea de servicio de
+ * timers (os_timer_service_task), que la aplicación debe crear como tarea básica de alta prioridad con el ID
+ * OS_TIMER_SERVICE_TASK_ID. systick_isr solo marca las alarmas expiradas y activa la tarea de servicio.
+ */
+//#define OS_TIMER_SERVICE    (1)
+
+#ifdef OS_TIMER_SERVICE
+#define OS_TIMER_SERVICE_TASK_ID    ((uint8_t) 3u)
+#endif /* OS_TIMER_SERVICE */
+
+/*
+ * Habilitar llamadas diferidas: una ISR registra una función y un argumento con os_defer_from_isr, y la tarea de
+ * servicio de timers la ejecuta. Requiere OS_TIMER_SERVICE.
+ */
+#ifdef OS_TIMER_SERVICE
+//#define OS_DEFERRED_CALLS   (1)
+#endif /* OS_TIMER_SERVICE */
+
+/* Número de llamadas diferidas pendientes que caben en la cola. Debe ser una potencia de 2, máximo 128. */
+#ifdef OS_DEFERRED_CALLS
+#define OS_DEFERRED_QUEUE_LEN   (8u)
+#endif /* OS_DEFERRED_CALLS */
+
+/*
+ * Habilitar corrutinas: tareas sin stack ni contexto propios (como las tareas básicas) que pueden esperar un tiempo o
+ * un elemento de una queue, guardando el punto donde continúan. Ver coroutines.h.
+ */
+//#define OS_COROUTINES       (1)
+
 /* Habilitar soporte para queues. */
 #define OS_QUEUES           (1)
 
-/* Nmero mximo de queues que pueden crearse. */
+/* Número máximo de queues que pueden crearse. Con OS_STATIC_CONFIG es el número de queues en app.oil. */
 #ifdef OS_QUEUES
+#ifndef OS_STATIC_CONFIG
 #define OS_QUEUE_COUNT_MAX  (2)
+#endif /* OS_STATIC_CONFIG */
 #endif /* OS_QUEUES */
 
-/* Nmero mximo de elementos que puede contener una queue. */
+/* Número máximo de elementos que puede contener una queue. */
 #ifdef OS_QUEUES
 #define OS_QUEUE_LEN_MAX    (5)
 #endif /* OS_QUEUES */
 
+/*
+ * Habilitar os_queue_reserve/os_queue_commit y os_queue_peek_acquire/os_queue_release: el emisor escribe y el receptor
+ * lee cada elemento directamente en el espacio de la queue, sin copias intermedias. Ver queues.h.
+ */
+#ifdef OS_QUEUES
+//#define OS_QUEUE_ZERO_COPY  (1)
+#endif /* OS_QUEUES */
+
+/*
+ * Habilitar mailboxes: un elemento que el escritor sobrescribe y los lectores leen sin sacarlo, con número de secuencia
+ * y tareas suscritas que se activan con cada escritura. Ver mailboxes.h.
+ */
+//#define OS_MAILBOXES        (1)
+
+/* Número de mailboxes. */
+#ifdef OS_MAILBOXES
+#define OS_MAILBOX_COUNT    (2u)
+#endif /* OS_MAILBOXES */
+
+/*
+ * Habilitar stream buffers: colas de bytes con un escritor y un lector, sin secciones críticas en el camino común.
+ * Ver streams.h.
+ */
+//#define OS_STREAM_BUFFERS   (1)
+
+/*
+ * Habilitar interrupciones de GPIO con un handler por pin y debounce por ticks (ver gpio_irq.h). Instala las ISRs de
+ * PORT1 y PORT2, entonces la aplicación no debe definir otras.
+ */
+//#define OS_GPIO_IRQ         (1)
+
+/* Número de pines que pueden tener handler. */
+#ifdef OS_GPIO_IRQ
+#define OS_GPIO_IRQ_SLOTS   (4u)
+#endif /* OS_GPIO_IRQ */
+
+/*
+ * Habilitar el profiler de secciones críticas: mide con el contador de systick cada ventana con interrupciones
+ * desactivadas (secciones críticas, scheduler, systick_isr) o con systick desactivado, y guarda la duración máxima y un
+ * histograma por punto del código. Ver profiler.h.
+ */
+//#define OS_CRITICAL_PROFILER    (1)
+
+#ifdef OS_CRITICAL_PROFILER
+/* Número de puntos del código que registra el profiler. Cada punto usa 16 bytes de RAM. */
+#define OS_PROFILER_SITES       (4u)
+/* Límite del primer intervalo del histograma. Cada intervalo siguiente duplica el límite (25, 50, 100 us, mayores). */
+#define OS_PROFILER_BUCKET_US   (25u)
+#endif /* OS_CRITICAL_PROFILER */
+
+/*
+ * Habilitar la política de bajo consumo de la tarea idle (os_idle, ver idle.h): elige LPM0, LPM3 o LPM4 según los ticks
+ * que faltan para el siguiente evento del kernel.
+ */
+//#define OS_LOW_POWER_IDLE   (1)
+
+#ifdef OS_LOW_POWER_IDLE
+/*
+ * Usar LPM3 con el timer de systick en ACLK (VLO, calibrado con SMCLK en os_init) cuando el siguiente evento está a
+ * OS_IDLE_TICKLESS_MIN_TICKS ticks o más. ACLK queda configurado con el VLO.
+ */
+#define OS_IDLE_TICKLESS    (1)
+
+#ifdef OS_IDLE_TICKLESS
+/* Cambiar de clock cuesta alrededor de un periodo de ACLK (83 us con el VLO a 12 kHz); no conviene para pocos ticks. */
+#define OS_IDLE_TICKLESS_MIN_TICKS  (5u)
+#endif /* OS_IDLE_TICKLESS */
+
+/* Usar LPM4 cuando no hay eventos del kernel programados. El tiempo del sistema no avanza en LPM4. */
+//#define OS_IDLE_ALLOW_LPM4  (1)
+
+/* Llamar a os_idle_pre_sleep_hook() y os_idle_post_sleep_hook() antes y después de dormir. */
+//#define OS_IDLE_HOOKS       (1)
+#endif /* OS_LOW_POWER_IDLE */
+
+/*
+ * Habilitar el supervisor de tareas: systick reinicia el watchdog solo si cada tarea supervisada se reportó dentro de su
+ * intervalo, y la primera tarea que lo excede queda registrada en RAM sin inicializar. Ver supervisor.h.
+ */
+//#define OS_SUPERVISOR       (1)
+
+/* Configuración del watchdog (WDT_ARST_* de msp430.h). ACLK (VLO, ~12 kHz) / 32768: reinicio en ~2.7 s. */
+#ifdef OS_SUPERVISOR
+#define OS_SUPERVISOR_WDT   (WDT_ARST_1000)
+#endif /* OS_SUPERVISOR */
+
+/*
+ * Habilitar el governor de frecuencia (ver dvfs.h): cambia la frecuencia del DCO según la carga del CPU que mide
+ * os_idle, conservando la duración del tick y el baud rate de la UART. Necesita OS_LOW_POWER_IDLE. SYSTICK_CLOCK_HZ es
+ * la frecuencia con la que main configura el DCO antes de os_init.
+ */
+//#define OS_DVFS             (1)
+
+#ifdef OS_DVFS
+/* Ticks por ventana de medición de carga. */
+#define OS_DVFS_WINDOW_TICKS    (100u)
+
+/* Carga (%) con la que el governor sube a la frecuencia máxima. */
+#define OS_DVFS_UP_PERCENT      (80u)
+
+/* El governor baja una frecuencia si la carga (%) a esa frecuencia sería menor que este valor. */
+#define OS_DVFS_DOWN_PERCENT    (60u)
+
+/* Frecuencia máxima, en MHz. 16 MHz necesita VCC de al menos 3.3 V. */
+#define OS_DVFS_MAX_MHZ         (16u)
+#endif /* OS_DVFS */
+
 #endif /* OS_CONFIG_H_ */
@@ -0,0 +1,81 @@
+/*
+ * os_gen_cfg.c
+ *
+ * Generado por tools/osgen.py a partir de app.oil. No editar, modificar app.oil y volver a generar.
+ */
+#include "os_private.h"
+
+#ifdef OS_STATIC_CONFIG
+
+/* Revisiones que dependen de os_config.h. */
+#if (OS_TASK_STACK_TOP - 3 * OS_TASK_STACK_BYTES) < 0x0200u
+#error "Los stacks de las tareas extendidas (3) no caben en la RAM"
+#endif
+#ifndef OS_QUEUES
+#error "La configuración tiene queues, habilitar OS_QUEUES"
+#endif
+#if 3 > OS_QUEUE_LEN_MAX
+#error "LENGTH de TEST_QUEUE es mayor que OS_QUEUE_LEN_MAX"
+#endif
+
+extern void another_task(void);
+extern void consumer_task(void);
+extern void idle_task(void);
+extern void producer_task(void);
+
+const task_config_t os_task_config[NUM_TASK_MAX] = {
+    [PRODUCER_TASK_ID] = {
+        .task_function = producer_task,
+        .priority = 3u,
+        .autostart = 0u,
+        .task_class = OS_TASK_CLASS_EXTENDED,
+        .context_id = 0u,
+    },
+    [CONSUMER_TASK_ID] = {
+        .task_function = consumer_task,
+        .priority = 3u,
+        .autostart = 1u,
+        .task_class = OS_TASK_CLASS_EXTENDED,
+        .context_id = 1u,
+    },
+    [ANOTHER_TASK_ID] = {
+        .task_function = another_task,
+        .priority = 4u,
+        .autostart = 0u,
+        .task_class = OS_TASK_CLASS_BASIC,
+        .context_id = 0u,
+    },
+    [IDLE_TASK_ID] = {
+        .task_function = idle_task,
+        .priority = 0u,
+        .autostart = 1u,
+        .task_class = OS_TASK_CLASS_EXTENDED,
+        .context_id = 2u,
+    },
+};
+
+const alarm_config_t os_alarm_config[OS_ALARM_COUNT] = {
+    [PRODUCER_ALARM_ID] = {
+        .task_to_activate = PRODUCER_TASK_ID,
+        .autostart = 1u,
+        .alarm_time = 100u,
+        .cycle_time = 0u,
+    },
+    [ANOTHER_ALARM_ID] = {
+        .task_to_activate = ANOTHER_TASK_ID,
+        .autostart = 1u,
+        .alarm_time = 5000u,
+        .cycle_time = 0u,
+    },
+};
+
+#ifdef OS_QUEUES
+const queue_config_t os_queue_config[OS_QUEUE_COUNT_MAX] = {
+    [TEST_QUEUE_ID] = {
+        .length = 3u,
+        .tasks_with_access = 0x03u,
+    },
+};
+#endif /* OS_QUEUES */
+
+#endif /* OS_STATIC_CONFIG */
@@ -0,0 +1,30 @@
+/*
+ * os_gen_cfg.h
+ *
+ * Generado por tools/osgen.py a partir de app.oil. No editar, modificar app.oil y volver a generar.
+ */
+
+#ifndef OS_GEN_CFG_H_
+#define OS_GEN_CFG_H_
+
+#include <stdint.h>
+
+#define NUM_TASK_MAX            ((uint8_t) 4u)
+#define OS_EXTENDED_TASK_COUNT  ((uint8_t) 3u)
+#define OS_ALARM_COUNT          ((uint8_t) 2u)
+#define OS_QUEUE_COUNT_MAX      (1)
+
+/* Tareas. */
+#define PRODUCER_TASK_ID        ((uint8_t) 0u)
+#define CONSUMER_TASK_ID        ((uint8_t) 1u)
+#define ANOTHER_TASK_ID         ((uint8_t) 2u)
+#define IDLE_TASK_ID            ((uint8_t) 3u)
+
+/* Alarmas. */
+#define PRODUCER_ALARM_ID       ((uint8_t) 0u)
+#define ANOTHER_ALARM_ID        ((uint8_t) 1u)
+
+/* Queues. */
+#define TEST_QUEUE_ID           ((uint8_t) 0u)
+
+#endif /* OS_GEN_CFG_H_ */
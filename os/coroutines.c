@@ -0,0 +1,41 @@
+/*
+ * coroutines.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include "coroutines.h"
+
+#include "os_private.h"
+
+#ifdef OS_COROUTINES
+
+#ifndef OS_STATIC_CONFIG
+error_id_e os_task_create_coroutine(os_task_id_t task_id, os_task_function_t task_function, uint8_t priority, uint8_t autostart)
+{
+    return task_create(task_id, task_function, priority, autostart, OS_TASK_CLASS_COROUTINE);
+}
+#endif /* OS_STATIC_CONFIG */
+
+error_id_e os_co_delay(tick_type_t ticks)
+{
+    if (OS_TASK_CLASS_COROUTINE != TASK_CONFIG(current_task).task_class)
+    {
+        return OS_ERROR_TASK_CLASS;
+    }
+
+    if (0u != ticks)
+    {
+        tasks[current_task].ticks_to_wait = ticks;
+        tasks[current_task].state = OS_TASK_STATE_WAIT;
+    }
+    else
+    {
+        // Sin espera, la corrutina sigue lista y el scheduler la vuelve a elegir si no hay otra tarea con prioridad.
+        tasks[current_task].state = OS_TASK_STATE_READY;
+    }
+
+    return OS_OK;
+}
+
+#endif /* OS_COROUTINES */
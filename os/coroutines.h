@@ -0,0 +1,129 @@
+/*
+ * coroutines.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+
+#ifndef OS_COROUTINES_H_
+#define OS_COROUTINES_H_
+
+#include <stdint.h>
+
+#include "os.h"
+#include "os_config.h"
+#include "tasks.h"
+#include "queues.h"
+
+/*
+ * Corrutinas ("protothreads"): tareas sin stack ni contexto propios que pueden esperar.
+ *
+ * Una corrutina se despacha igual que una tarea básica (una llamada anidada desde el scheduler), pero en cada punto
+ * de espera (OS_CO_DELAY, OS_CO_WAIT_QUEUE) guarda la línea donde debe continuar y retorna al scheduler. Cuando el
+ * OS la vuelve a pasar a estado ready (por timeout o porque la queue recibió un elemento), el scheduler la llama otra
+ * vez y la corrutina continúa desde esa línea.
+ *
+ * Como el stack no se conserva entre puntos de espera, las variables locales pierden su valor. Usar variables static
+ * o campos de una estructura. Tampoco se puede usar switch alrededor de un punto de espera.
+ *
+ * Ejemplo:
+ *
+ * static void blink_coroutine(void)
+ * {
+ *     static os_co_t co;
+ *     static error_id_e status;
+ *     static uint8_t * item;
+ *
+ *     OS_CO_BEGIN(&co);
+ *
+ *     while (1)
+ *     {
+ *         OS_CO_WAIT_QUEUE(&co, LED_QUEUE_ID, &item, (tick_type_t) 500u, status);
+ *         hal_gpio_toggle(GPIO_PORT_1, GREEN_LED_PIN);
+ *         OS_CO_DELAY(&co, (tick_type_t) 100u);
+ *     }
+ *
+ *     OS_CO_END(&co);
+ * }
+ */
+
+typedef struct _os_co_t {
+    uint16_t resume_line;               /* Línea donde continúa la corrutina. Es 0 si inicia desde el principio. */
+    uint8_t waiting;                    /* Distinto de 0 si la corrutina está en un punto de espera. */
+} os_co_t;
+
+#define OS_CO_BEGIN(co)     switch ((co)->resume_line) { case 0u:
+
+#define OS_CO_END(co)       }\
+                            (co)->resume_line = 0u;\
+                            (co)->waiting = 0u;\
+                            os_task_terminate();\
+                            return
+
+/*
+ * Espera ticks ticks. Con ticks igual a 0 solo cede el CPU a otras tareas listas de mayor o igual prioridad.
+ */
+#define OS_CO_DELAY(co, ticks) do {\
+    (co)->resume_line = __LINE__;\
+    os_co_delay(ticks);\
+    return;\
+    case __LINE__:;\
+} while (0)
+
+/*
+ * Recibe un elemento de una queue, esperando hasta ticks_to_wait ticks si la queue está vacía. Al continuar, status
+ * tiene el resultado de os_co_queue_receive (OS_OK, OS_ERROR_QUEUE_EMPTY u OS_ERROR_INVALID_ARGUMENT).
+ */
+#define OS_CO_WAIT_QUEUE(co, id, out_item, ticks_to_wait, status) do {\
+    (co)->resume_line = __LINE__;\
+    case __LINE__:\
+    (status) = os_co_queue_receive((co), (id), (void *) (out_item), (ticks_to_wait));\
+    if (OS_PENDING == (status))\
+    {\
+        return;\
+    }\
+} while (0)
+
+#ifndef OS_STATIC_CONFIG
+/**
+ * @brief Registra los atributos de una nueva corrutina.
+ *
+ * La función de la corrutina debe usar OS_CO_BEGIN y OS_CO_END. Igual que una tarea básica, no tiene stack ni contexto
+ * propios; solo puede esperar en los puntos de espera OS_CO_*.
+ *
+ * @param task_id Identificador único de la tarea.
+ * @param task_function Dirección de inicio de la corrutina.
+ * @param priority Prioridad de la tarea (0-255).
+ * @param autostart Si es TRUE, inicializar el OS activa automáticamente la tarea.
+ *
+ * @return OS_OK si registró la tarea.
+ *         OS_ERROR_INVALID_ARGUMENT si el valor de task_id no es un identificador válido.
+ */
+error_id_e os_task_create_coroutine(os_task_id_t task_id, os_task_function_t task_function, uint8_t priority, uint8_t autostart);
+#endif /* OS_STATIC_CONFIG */
+
+/**
+ * @brief Pasa la corrutina actual a estado wait por ticks ticks. Usar a través de OS_CO_DELAY.
+ *
+ * @return OS_OK si la corrutina debe retornar al scheduler.
+ *         OS_ERROR_TASK_CLASS si la tarea actual no es una corrutina.
+ */
+error_id_e os_co_delay(tick_type_t ticks);
+
+/**
+ * @brief Recibe un elemento de una queue desde una corrutina. Usar a través de OS_CO_WAIT_QUEUE.
+ *
+ * @param co Estado de la corrutina.
+ * @param id Identificador único de la queue.
+ * @param out_item Espacio para recibir el elemento desde la queue.
+ * @param ticks_to_wait Ticks que espera la corrutina si la queue está vacía.
+ *
+ * @return OS_OK si recibió un elemento de la queue.
+ *         OS_PENDING si la queue está vacía y la corrutina debe retornar al scheduler para esperar.
+ *         OS_ERROR_QUEUE_EMPTY si la queue está vacía y expiró el timeout (o ticks_to_wait es 0).
+ *         OS_ERROR_INVALID_ARGUMENT si uno de los parámetros es incorrecto.
+ *         OS_ERROR_TASK_CLASS si la tarea actual no es una corrutina.
+ */
+error_id_e os_co_queue_receive(os_co_t * co, queue_id_t id, void * out_item, tick_type_t ticks_to_wait);
+
+#endif /* OS_COROUTINES_H_ */
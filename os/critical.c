@@ -0,0 +1,146 @@
+/*
+ * critical.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include <msp430.h>
+
+#include "critical.h"
+#include "profiler.h"
+
+#include "os_private.h"
+
+#include "em.h"
+
+volatile critical_state_t os_critical;
+
+#ifdef OS_CRITICAL_PROFILER
+void os_enter_critical_at(const char * file, uint16_t line)
+#else
+void os_enter_critical(void)
+#endif /* OS_CRITICAL_PROFILER */
+{
+    uint16_t interrupt_state = __get_SR_register() & GIE;
+
+    EM_GLOBAL_INTERRUPT_DIS;
+
+    if (0u == os_critical.nesting++)
+    {
+        os_critical.interrupt_state = (0u != interrupt_state);
+
+#ifdef OS_CRITICAL_PROFILER
+        if (interrupt_state)
+        {
+            profiler_start(OS_PROFILER_KIND_IRQ, file, line);
+        }
+#endif /* OS_CRITICAL_PROFILER */
+    }
+}
+
+void os_exit_critical(void)
+{
+    if (0u == os_critical.nesting || 0u != (--os_critical.nesting))
+    {
+        return;
+    }
+
+    if (os_switch_pending && 0u == os_critical.tick_nesting)
+    {
+        // Una ISR activó una tarea durante una sección crítica respecto a systick que terminó dentro de esta sección.
+        os_switch_pending = 0u;
+        scheduler_preempt();
+    }
+
+    if (os_critical.interrupt_state)
+    {
+        PROFILER_STOP(OS_PROFILER_KIND_IRQ);
+        EM_GLOBAL_INTERRUPT_EN;
+    }
+}
+
+#ifdef OS_CRITICAL_PROFILER
+void os_enter_tick_critical_at(const char * file, uint16_t line)
+#else
+void os_enter_tick_critical(void)
+#endif /* OS_CRITICAL_PROFILER */
+{
+    uint16_t interrupt_state = __get_SR_register() & GIE;
+
+    // Leer y desactivar CCIE no es atómico respecto a una ISR que cambie de tarea.
+    EM_GLOBAL_INTERRUPT_DIS;
+
+    if (0u == os_critical.tick_nesting++)
+    {
+        os_critical.tick_interrupt_state = (0u != (SYSTICK_CCTL & CCIE));
+        SYSTICK_CCTL &= ~CCIE;
+
+#ifdef OS_CRITICAL_PROFILER
+        if (os_critical.tick_interrupt_state)
+        {
+            profiler_start(OS_PROFILER_KIND_TICK, file, line);
+        }
+#endif /* OS_CRITICAL_PROFILER */
+    }
+
+    if (interrupt_state)
+    {
+        EM_GLOBAL_INTERRUPT_EN;
+    }
+}
+
+void os_exit_tick_critical(void)
+{
+    uint16_t interrupt_state = __get_SR_register() & GIE;
+
+    EM_GLOBAL_INTERRUPT_DIS;
+
+    if (0u != os_critical.tick_nesting && 0u == (--os_critical.tick_nesting))
+    {
+        if (os_critical.tick_interrupt_state)
+        {
+            PROFILER_STOP(OS_PROFILER_KIND_TICK);
+            SYSTICK_CCTL |= CCIE;
+        }
+
+        if (os_switch_pending && 0u == os_critical.nesting)
+        {
+            // Una ISR activó una tarea durante la sección crítica.
+            os_switch_pending = 0u;
+            scheduler_preempt();
+        }
+    }
+
+    if (interrupt_state)
+    {
+        EM_GLOBAL_INTERRUPT_EN;
+    }
+}
+
+critical_state_t critical_suspend(void)
+{
+    critical_state_t critical = os_critical;
+
+    // Las ventanas del profiler terminan cuando la tarea deja de ejecutarse.
+    PROFILER_STOP(OS_PROFILER_KIND_IRQ);
+    PROFILER_STOP(OS_PROFILER_KIND_TICK);
+
+    if (0u != critical.tick_nesting && critical.tick_interrupt_state)
+    {
+        SYSTICK_CCTL |= CCIE;
+    }
+
+    os_critical = (critical_state_t) { 0u };
+
+    return critical;
+}
+
+void critical_resume(critical_state_t critical)
+{
+    os_critical = critical;
+
+    if (0u != critical.tick_nesting)
+    {
+        SYSTICK_CCTL &= ~CCIE;
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * critical.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+
+#ifndef OS_CRITICAL_H_
+#define OS_CRITICAL_H_
+
+#include <stdint.h>
+
+#include "os.h"
+#include "os_config.h"
+
+/*
+ * Secciones críticas anidables. Cada os_enter_critical debe tener su os_exit_critical; solo la salida de la sección
+ * externa recupera el estado que tenían las interrupciones antes de entrar, entonces un servicio del OS que usa una
+ * sección crítica se puede llamar desde otra sección crítica sin activar interrupciones antes de tiempo.
+ *
+ * El anidamiento es parte del contexto de cada tarea: si una tarea espera dentro de una sección crítica (por ejemplo,
+ * en una queue), las demás tareas se ejecutan con interrupciones activadas y la sección continúa cuando la tarea
+ * vuelve a ejecutarse.
+ */
+
+/*
+ * Con OS_CRITICAL_PROFILER, os_enter_critical y os_enter_tick_critical registran el punto del código que los llama.
+ */
+#ifdef OS_CRITICAL_PROFILER
+#define os_enter_critical()         os_enter_critical_at(__FILE__, __LINE__)
+#define os_enter_tick_critical()    os_enter_tick_critical_at(__FILE__, __LINE__)
+
+void os_enter_critical_at(const char * file, uint16_t line);
+void os_enter_tick_critical_at(const char * file, uint16_t line);
+#else
+/**
+ * @brief Inicia una sección crítica: desactiva todas las interrupciones.
+ */
+void os_enter_critical(void);
+
+/**
+ * @brief Inicia una sección crítica respecto a systick: solo desactiva la interrupción del timer de systick.
+ *
+ * Protege datos que solo modifican las tareas y systick_isr (alarmas, tablas de activación), sin aumentar la latencia
+ * de las demás ISRs. Si una ISR activa una tarea durante la sección, el cambio de contexto se pospone hasta
+ * os_exit_tick_critical. La sección debe durar menos de un tick; el tick pendiente se procesa al terminarla.
+ */
+void os_enter_tick_critical(void);
+#endif /* OS_CRITICAL_PROFILER */
+
+/**
+ * @brief Termina una sección crítica. Si es la sección externa, vuelve a activar las interrupciones solo si estaban
+ * activadas en el os_enter_critical correspondiente.
+ */
+void os_exit_critical(void);
+
+/**
+ * @brief Termina una sección crítica respecto a systick. Si es la sección externa, recupera el estado de la
+ * interrupción de systick y ejecuta el cambio de contexto que haya pospuesto una ISR.
+ */
+void os_exit_tick_critical(void);
+
+#endif /* OS_CRITICAL_H_ */
@@ -0,0 +1,80 @@
+/*
+ * deferred.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include "deferred.h"
+
+#include "os_private.h"
+
+#ifdef OS_DEFERRED_CALLS
+
+#if (0u != (OS_DEFERRED_QUEUE_LEN & (OS_DEFERRED_QUEUE_LEN - 1u))) || (128u < OS_DEFERRED_QUEUE_LEN)
+#error "OS_DEFERRED_QUEUE_LEN debe ser una potencia de 2, máximo 128"
+#endif
+
+typedef struct _deferred_call_t {
+    os_deferred_fn_t fn;
+    void * arg;
+} deferred_call_t;
+
+static deferred_call_t deferred_calls[OS_DEFERRED_QUEUE_LEN];
+
+/*
+ * Índices libres (no se reinician al llegar a OS_DEFERRED_QUEUE_LEN): head - tail es el número de llamadas pendientes.
+ * Solo os_defer_from_isr modifica head, y solo deferred_calls_run modifica tail.
+ */
+static volatile uint8_t deferred_head;
+static volatile uint8_t deferred_tail;
+
+error_id_e os_defer_from_isr(os_deferred_fn_t fn, void * arg)
+{
+    uint8_t head = deferred_head;
+
+    if (0 == fn)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (OS_DEFERRED_QUEUE_LEN <= (uint8_t) (head - deferred_tail))
+    {
+        return OS_ERROR_QUEUE_FULL;
+    }
+
+    deferred_calls[head & (OS_DEFERRED_QUEUE_LEN - 1u)] = (deferred_call_t) {
+        .fn = fn,
+        .arg = arg,
+    };
+
+    // Publicar la llamada hasta después de escribirla.
+    deferred_head = head + 1u;
+
+    if (timer_service_activate())
+    {
+        os_switch_pending = 1u;
+    }
+
+    return OS_OK;
+}
+
+void deferred_calls_run(void)
+{
+    uint8_t tail = deferred_tail;
+    // Solo ejecutar las llamadas registradas hasta ahora. Las que lleguen durante el lote registran otra activación.
+    uint8_t head = deferred_head;
+    deferred_call_t call;
+
+    while (tail != head)
+    {
+        call = deferred_calls[tail & (OS_DEFERRED_QUEUE_LEN - 1u)];
+        tail++;
+
+        // Liberar el espacio antes de ejecutar la llamada, para que una ISR pueda volver a usarlo.
+        deferred_tail = tail;
+
+        call.fn(call.arg);
+    }
+}
+
+#endif /* OS_DEFERRED_CALLS */
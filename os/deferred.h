@@ -0,0 +1,42 @@
+/*
+ * deferred.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+
+#ifndef OS_DEFERRED_H_
+#define OS_DEFERRED_H_
+
+#include <stdint.h>
+
+#include "os.h"
+#include "os_config.h"
+
+typedef void (*os_deferred_fn_t)(void * arg);
+
+/**
+ * @brief Registra una llamada diferida desde una ISR. La tarea de servicio de timers ejecuta fn(arg), en orden de
+ * registro, la siguiente vez que el scheduler la elige.
+ *
+ * La ISR solo copia fn y arg a una cola circular y activa la tarea de servicio; el resto del trabajo de la ISR se
+ * ejecuta en fn, bajo el control del scheduler y con interrupciones activadas. La cola no usa secciones críticas: las
+ * ISRs son el único productor (en el MSP430 no se anidan) y la tarea de servicio es el único consumidor. Para que la
+ * tarea de servicio se ejecute al terminar la ISR, la ISR debe estar declarada con OS_ISR en os/port.asm.
+ *
+ * Medición en el simulador (host/) a 8 MHz, con un handler de os_gpio_irq_attach que cambia un LED, envía 8 bytes por
+ * la UART y calcula unos 50 us (__delay_cycles(400)): la ISR de PORT1 dura 52.5 us con el trabajo en la ISR y 1.5 us
+ * con os_defer_from_isr. Con debounce, el handler se ejecuta en systick_isr, que dura 54 us y 3 us. Con la llamada
+ * diferida, el trabajo termina entre 1 y 3 us más tarde. El simulador solo cuenta los accesos a registros y
+ * __delay_cycles, entonces en el MSP430 las dos duraciones son mayores por las instrucciones del kernel.
+ *
+ * @param fn Función que se ejecuta en la tarea de servicio.
+ * @param arg Argumento para fn.
+ *
+ * @return OS_OK si registró la llamada.
+ *         OS_ERROR_INVALID_ARGUMENT si fn es nulo.
+ *         OS_ERROR_QUEUE_FULL si la cola tiene OS_DEFERRED_QUEUE_LEN llamadas pendientes. La llamada se descarta.
+ */
+error_id_e os_defer_from_isr(os_deferred_fn_t fn, void * arg);
+
+#endif /* OS_DEFERRED_H_ */
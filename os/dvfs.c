@@ -0,0 +1,193 @@
+/*
+ * dvfs.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include <msp430.h>
+
+#include "dvfs.h"
+#include "systime.h"
+
+#include "os_private.h"
+
+#include "em.h"
+#include "hal_timer.h"
+#include "hal_uart.h"
+
+#ifdef OS_DVFS
+
+#ifndef OS_LOW_POWER_IDLE
+#error "OS_DVFS necesita OS_LOW_POWER_IDLE: os_idle mide el tiempo que el CPU duerme"
+#endif
+
+/* Frecuencia del DCO que configura main antes de os_init, en MHz. */
+#define DVFS_BOOT_MHZ       (SYSTICK_CLOCK_HZ / 1000000uL)
+
+#if (1u != DVFS_BOOT_MHZ) && (8u != DVFS_BOOT_MHZ) && (12u != DVFS_BOOT_MHZ) && (16u != DVFS_BOOT_MHZ)
+#error "SYSTICK_CLOCK_HZ debe ser una frecuencia calibrada del DCO (1, 8, 12 o 16 MHz)"
+#endif
+
+#if (OS_DVFS_MAX_MHZ < DVFS_BOOT_MHZ)
+#error "OS_DVFS_MAX_MHZ debe ser mayor o igual que SYSTICK_CLOCK_HZ"
+#endif
+
+#if ((SYSTICK_PERIOD * OS_DVFS_MAX_MHZ) / DVFS_BOOT_MHZ) > 0xFFFFu
+#error "El periodo de systick a OS_DVFS_MAX_MHZ no cabe en 16 bits"
+#endif
+
+#if (UART_CLOCK_HZ != SYSTICK_CLOCK_HZ) || (HAL_TIMER_CLOCK_HZ != SYSTICK_CLOCK_HZ)
+#error "UART_CLOCK_HZ, HAL_TIMER_CLOCK_HZ y SYSTICK_CLOCK_HZ deben ser la frecuencia inicial del DCO"
+#endif
+
+#define DVFS_LEVEL_COUNT    (4u)
+
+#define DVFS_BOOT_LEVEL     ((1u == DVFS_BOOT_MHZ) ? 0u : (8u == DVFS_BOOT_MHZ) ? 1u : (12u == DVFS_BOOT_MHZ) ? 2u : 3u)
+
+/* Duración de una ventana del governor, en cuentas de SYSTICK_CLOCK_HZ (timestamps). */
+#define DVFS_WINDOW_COUNTS  ((uint32_t) OS_DVFS_WINDOW_TICKS * SYSTICK_PERIOD)
+
+static const uint8_t dvfs_levels_mhz[DVFS_LEVEL_COUNT] = { 1u, 8u, 12u, 16u };
+
+volatile uint16_t dvfs_systick_period = SYSTICK_PERIOD;
+
+static uint8_t dvfs_level = DVFS_BOOT_LEVEL;
+static uint8_t dvfs_target = DVFS_BOOT_LEVEL;
+static uint8_t dvfs_load;
+static uint16_t dvfs_window_ticks;
+
+/* Tiempo que el CPU durmió en la ventana actual, en cuentas de SYSTICK_CLOCK_HZ. */
+static uint32_t dvfs_idle_counts;
+/* Timestamp del inicio del tiempo dormido que aún no está en dvfs_idle_counts. */
+static os_timestamp_t dvfs_sleep_start;
+static uint8_t dvfs_sleeping;
+
+static void dvfs_apply(void);
+
+void dvfs_idle_enter(void)
+{
+    dvfs_sleep_start = os_timestamp_get();
+    dvfs_sleeping = 1u;
+}
+
+void dvfs_idle_exit(void)
+{
+    if (dvfs_sleeping)
+    {
+        dvfs_idle_counts += os_timestamp_get() - dvfs_sleep_start;
+        dvfs_sleeping = 0u;
+    }
+}
+
+void dvfs_tick(void)
+{
+    os_timestamp_t now;
+    uint32_t busy_counts;
+
+    if (dvfs_target != dvfs_level)
+    {
+        // Un cambio que esperaba a la UART.
+        dvfs_apply();
+    }
+
+    if (OS_DVFS_WINDOW_TICKS > ++dvfs_window_ticks)
+    {
+        return;
+    }
+
+    dvfs_window_ticks = 0u;
+
+    // systick interrumpe el sueño de os_idle: el tiempo dormido hasta ahora es parte de esta ventana.
+    if (dvfs_sleeping)
+    {
+        now = os_timestamp_get();
+        dvfs_idle_counts += now - dvfs_sleep_start;
+        dvfs_sleep_start = now;
+    }
+
+    busy_counts = (DVFS_WINDOW_COUNTS > dvfs_idle_counts) ? (DVFS_WINDOW_COUNTS - dvfs_idle_counts) : 0u;
+    dvfs_idle_counts = 0u;
+
+    dvfs_load = (uint8_t) (busy_counts / (DVFS_WINDOW_COUNTS / 100u));
+
+    if (OS_DVFS_UP_PERCENT <= dvfs_load)
+    {
+        dvfs_target = DVFS_LEVEL_COUNT - 1u;
+        while (OS_DVFS_MAX_MHZ < dvfs_levels_mhz[dvfs_target])
+        {
+            dvfs_target--;
+        }
+    }
+    else if (0u < dvfs_level &&
+             OS_DVFS_DOWN_PERCENT > ((uint16_t) dvfs_load * dvfs_levels_mhz[dvfs_level]) / dvfs_levels_mhz[dvfs_level - 1u])
+    {
+        dvfs_target = dvfs_level - 1u;
+    }
+
+    if (dvfs_target != dvfs_level)
+    {
+        dvfs_apply();
+    }
+}
+
+/*
+ * Cambia el DCO a la frecuencia de dvfs_target y ajusta systick, la UART y hal_timer_delay. Se llama desde
+ * systick_handler, con interrupciones desactivadas.
+ */
+static void dvfs_apply(void)
+{
+    uint8_t old_mhz = dvfs_levels_mhz[dvfs_level];
+    uint8_t new_mhz = dvfs_levels_mhz[dvfs_target];
+    uint16_t remaining;
+
+    if (SYSTICK_CCTL & CCIFG)
+    {
+        // Hay un tick sin procesar: la fase del siguiente tick ya pasó. Reintentar en el siguiente tick.
+        return;
+    }
+
+    if (0u == hal_uart_set_clock((uint32_t) new_mhz * 1000000uL))
+    {
+        // La UART transmite un byte. Reintentar en el siguiente tick.
+        return;
+    }
+
+    // Cuentas hasta el siguiente tick a la frecuencia anterior.
+    remaining = SYSTICK_CCR - SYSTICK_TAR;
+
+    switch (new_mhz)
+    {
+    case 1u:
+        DCO_CAL_1MHZ();
+        break;
+    case 8u:
+        DCO_CAL_8MHZ();
+        break;
+    case 12u:
+        DCO_CAL_12MHZ();
+        break;
+    default:
+        DCO_CAL_16MHZ();
+        break;
+    }
+
+    // El siguiente tick queda a la misma distancia en tiempo.
+    SYSTICK_CCR = SYSTICK_TAR + (uint16_t) (((uint32_t) remaining * new_mhz) / old_mhz);
+    dvfs_systick_period = (uint16_t) (((uint32_t) SYSTICK_PERIOD * new_mhz) / DVFS_BOOT_MHZ);
+
+    hal_timer_set_clock((uint32_t) new_mhz * 1000000uL);
+
+    dvfs_level = dvfs_target;
+}
+
+uint8_t os_dvfs_get_mhz(void)
+{
+    return dvfs_levels_mhz[dvfs_level];
+}
+
+uint8_t os_dvfs_get_load(void)
+{
+    return dvfs_load;
+}
+
+#endif /* OS_DVFS */
@@ -0,0 +1,46 @@
+/*
+ * dvfs.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+
+#ifndef OS_DVFS_H_
+#define OS_DVFS_H_
+
+#include <stdint.h>
+
+#include "os.h"
+#include "os_config.h"
+
+/*
+ * Governor de frecuencia. os_idle mide el tiempo que el CPU duerme y, cada OS_DVFS_WINDOW_TICKS ticks, systick calcula
+ * la carga del CPU en la ventana y elige la frecuencia del DCO entre las frecuencias calibradas (1, 8, 12 y 16 MHz,
+ * hasta OS_DVFS_MAX_MHZ):
+ *
+ * - Si la carga llega a OS_DVFS_UP_PERCENT, sube directo a la frecuencia máxima.
+ * - Si la carga que tendría a la frecuencia anterior es menor que OS_DVFS_DOWN_PERCENT, baja una frecuencia.
+ *
+ * Al cambiar la frecuencia, systick ajusta su periodo y la fase del siguiente tick, la UART su divisor y
+ * hal_timer_delay sus cuentas por milisegundo, entonces la duración del tick, el baud rate y las esperas no cambian.
+ * La UART no puede cambiar de divisor a la mitad de un byte: mientras transmite, el cambio espera al siguiente tick
+ * con la UART libre.
+ *
+ * Los timestamps (systime.h) siguen en cuentas de SYSTICK_CLOCK_HZ a cualquier frecuencia.
+ */
+
+/**
+ * @brief Obtiene la frecuencia actual del DCO (MCLK y SMCLK).
+ *
+ * @return Frecuencia en MHz.
+ */
+uint8_t os_dvfs_get_mhz(void);
+
+/**
+ * @brief Obtiene la carga del CPU en la última ventana del governor.
+ *
+ * @return Porcentaje del tiempo que el CPU no estuvo en os_idle (0 a 100).
+ */
+uint8_t os_dvfs_get_load(void);
+
+#endif /* OS_DVFS_H_ */
@@ -0,0 +1,253 @@
+/*
+ * gpio_irq.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include "gpio_irq.h"
+#include "critical.h"
+
+#include "os_private.h"
+
+#ifdef OS_GPIO_IRQ
+
+#define GPIO_SLOT_USED          (0x01u)
+#define GPIO_SLOT_LEVEL         (0x02u)     /* Último nivel reportado, para OS_GPIO_EDGE_BOTH. */
+#define GPIO_SLOT_DEBOUNCING    (0x04u)
+
+typedef struct _gpio_slot_t {
+    os_gpio_handler_t handler;
+    tick_type_t debounce_ticks;
+    tick_type_t countdown;              /* Ticks restantes de debounce. */
+    gpio_port_t port;
+    uint8_t pin;
+    uint8_t edge;
+    uint8_t state;
+} gpio_slot_t;
+
+static volatile gpio_slot_t gpio_slots[OS_GPIO_IRQ_SLOTS];
+
+static void gpio_irq_arm(uint8_t slot);
+static void gpio_irq_dispatch(gpio_port_t port);
+static void gpio_irq_report(uint8_t slot, uint8_t level);
+
+error_id_e os_gpio_irq_attach(gpio_port_t port, uint8_t pin, os_gpio_edge_e edge, tick_type_t debounce_ticks,
+                              os_gpio_handler_t handler)
+{
+    error_id_e status = OS_OK;
+    uint8_t free_slot = OS_GPIO_IRQ_SLOTS;
+    uint8_t i;
+
+    if ((GPIO_PORT_1 != port && GPIO_PORT_2 != port) || 0u == pin || 0u != (pin & (pin - 1u)) ||
+        OS_GPIO_EDGE_BOTH < edge || 0 == handler)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    os_enter_critical();
+
+    i = OS_GPIO_IRQ_SLOTS;
+    while (i--)
+    {
+        if (0u == (GPIO_SLOT_USED & gpio_slots[i].state))
+        {
+            free_slot = i;
+        }
+        else if (port == gpio_slots[i].port && pin == gpio_slots[i].pin)
+        {
+            // El pin ya tiene handler, reemplazarlo.
+            free_slot = i;
+            break;
+        }
+    }
+
+    if (OS_GPIO_IRQ_SLOTS <= free_slot)
+    {
+        status = OS_ERROR_NO_SLOTS;
+    }
+    else
+    {
+        hal_gpio_irq_disable(port, pin);
+
+        gpio_slots[free_slot].handler = handler;
+        gpio_slots[free_slot].debounce_ticks = debounce_ticks;
+        gpio_slots[free_slot].countdown = 0u;
+        gpio_slots[free_slot].port = port;
+        gpio_slots[free_slot].pin = pin;
+        gpio_slots[free_slot].edge = edge;
+        gpio_slots[free_slot].state = GPIO_SLOT_USED | (hal_gpio_read(port, pin) ? GPIO_SLOT_LEVEL : 0u);
+
+        gpio_irq_arm(free_slot);
+    }
+
+    os_exit_critical();
+
+    return status;
+}
+
+error_id_e os_gpio_irq_detach(gpio_port_t port, uint8_t pin)
+{
+    error_id_e status = OS_ERROR_INVALID_ARGUMENT;
+    uint8_t i;
+
+    os_enter_critical();
+
+    i = OS_GPIO_IRQ_SLOTS;
+    while (i--)
+    {
+        if ((GPIO_SLOT_USED & gpio_slots[i].state) && port == gpio_slots[i].port && pin == gpio_slots[i].pin)
+        {
+            hal_gpio_irq_disable(port, pin);
+            gpio_slots[i].state = 0u;
+            status = OS_OK;
+        }
+    }
+
+    os_exit_critical();
+
+    return status;
+}
+
+void gpio_port1_handler(void)
+{
+    gpio_irq_dispatch(GPIO_PORT_1);
+}
+
+void gpio_port2_handler(void)
+{
+    gpio_irq_dispatch(GPIO_PORT_2);
+}
+
+void gpio_irq_tick(void)
+{
+    uint8_t i;
+    uint8_t level;
+
+    i = OS_GPIO_IRQ_SLOTS;
+    while (i--)
+    {
+        if (0u == (GPIO_SLOT_DEBOUNCING & gpio_slots[i].state) || 0u != (--gpio_slots[i].countdown))
+        {
+            continue;
+        }
+
+        gpio_slots[i].state &= ~GPIO_SLOT_DEBOUNCING;
+
+        // El nivel se mantuvo debounce_ticks ticks. Reportarlo solo si corresponde al flanco configurado.
+        level = (0u != hal_gpio_read(gpio_slots[i].port, gpio_slots[i].pin));
+        gpio_irq_report(i, level);
+        gpio_irq_arm(i);
+    }
+}
+
+#ifdef OS_LOW_POWER_IDLE
+void gpio_irq_next_event(tick_type_t * next)
+{
+    uint8_t i;
+
+    i = OS_GPIO_IRQ_SLOTS;
+    while (i--)
+    {
+        if (GPIO_SLOT_DEBOUNCING & gpio_slots[i].state)
+        {
+            OS_NEXT_EVENT(*next, gpio_slots[i].countdown);
+        }
+    }
+}
+
+#ifdef OS_IDLE_TICKLESS
+void gpio_irq_skip(tick_type_t ticks)
+{
+    uint8_t i;
+
+    i = OS_GPIO_IRQ_SLOTS;
+    while (i--)
+    {
+        if (GPIO_SLOT_DEBOUNCING & gpio_slots[i].state)
+        {
+            gpio_slots[i].countdown -= ticks;
+        }
+    }
+}
+#endif /* OS_IDLE_TICKLESS */
+#endif /* OS_LOW_POWER_IDLE */
+
+/*
+ * Activa la interrupción del pin para el siguiente flanco. Con OS_GPIO_EDGE_BOTH, el siguiente flanco es el contrario
+ * al último nivel reportado.
+ */
+static void gpio_irq_arm(uint8_t slot)
+{
+    uint8_t falling;
+
+    if (OS_GPIO_EDGE_BOTH == gpio_slots[slot].edge)
+    {
+        falling = (GPIO_SLOT_LEVEL & gpio_slots[slot].state) ? gpio_slots[slot].pin : 0u;
+    }
+    else
+    {
+        falling = (OS_GPIO_EDGE_FALLING == gpio_slots[slot].edge) ? gpio_slots[slot].pin : 0u;
+    }
+
+    hal_gpio_irq_enable(gpio_slots[slot].port, gpio_slots[slot].pin, falling);
+}
+
+static void gpio_irq_dispatch(gpio_port_t port)
+{
+    uint8_t pending = hal_gpio_irq_pending(port);
+    uint8_t i;
+
+    hal_gpio_irq_clear(port, pending);
+
+    i = OS_GPIO_IRQ_SLOTS;
+    while (i--)
+    {
+        if (0u == (GPIO_SLOT_USED & gpio_slots[i].state) || port != gpio_slots[i].port ||
+            0u == (pending & gpio_slots[i].pin))
+        {
+            continue;
+        }
+
+        if (0u != gpio_slots[i].debounce_ticks)
+        {
+            // Ignorar los rebotes hasta que gpio_irq_tick revise el nivel.
+            hal_gpio_irq_disable(port, gpio_slots[i].pin);
+            gpio_slots[i].countdown = gpio_slots[i].debounce_ticks;
+            gpio_slots[i].state |= GPIO_SLOT_DEBOUNCING;
+        }
+        else if (OS_GPIO_EDGE_BOTH == gpio_slots[i].edge)
+        {
+            gpio_irq_report(i, (0u != hal_gpio_read(port, gpio_slots[i].pin)));
+            gpio_irq_arm(i);
+        }
+        else
+        {
+            gpio_irq_report(i, (OS_GPIO_EDGE_RISING == gpio_slots[i].edge));
+        }
+    }
+}
+
+static void gpio_irq_report(uint8_t slot, uint8_t level)
+{
+    uint8_t last_level = (0u != (GPIO_SLOT_LEVEL & gpio_slots[slot].state));
+
+    if (OS_GPIO_EDGE_BOTH == gpio_slots[slot].edge ? (level == last_level) :
+        (level != (OS_GPIO_EDGE_RISING == gpio_slots[slot].edge)))
+    {
+        // Después del debounce el pin regresó a su nivel anterior; fue ruido.
+        return;
+    }
+
+    if (level)
+    {
+        gpio_slots[slot].state |= GPIO_SLOT_LEVEL;
+    }
+    else
+    {
+        gpio_slots[slot].state &= ~GPIO_SLOT_LEVEL;
+    }
+
+    gpio_slots[slot].handler(OS_GPIO_EVENT(gpio_slots[slot].port, gpio_slots[slot].pin, level));
+}
+
+#endif /* OS_GPIO_IRQ */
@@ -0,0 +1,75 @@
+/*
+ * gpio_irq.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+
+#ifndef OS_GPIO_IRQ_H_
+#define OS_GPIO_IRQ_H_
+
+#include <stdint.h>
+
+#include "os.h"
+#include "os_config.h"
+#include "hal_gpio.h"
+
+/*
+ * Interrupciones de GPIO con un handler por pin. Las ISRs de PORT1 y PORT2 (declaradas con OS_ISR en os/port.asm)
+ * llaman al handler de cada pin que cambió, con un registro del cambio (os_gpio_event_t). El handler se ejecuta en
+ * contexto de interrupción, entonces solo puede usar los servicios *_from_isr, por ejemplo:
+ *
+ * static void button_handler(os_gpio_event_t event)
+ * {
+ *     os_queue_send_from_isr(BUTTON_QUEUE_ID, (const void *) event);
+ * }
+ *
+ * os_gpio_irq_attach(GPIO_PORT_1, BUTTON_PIN, OS_GPIO_EDGE_BOTH, (tick_type_t) 20u, button_handler);
+ *
+ * Con debounce_ticks distinto de 0, el primer flanco desactiva la interrupción del pin. systick_isr lee el pin
+ * debounce_ticks ticks después y llama al handler solo si el nivel corresponde al flanco; después vuelve a activar la
+ * interrupción. No hay espera activa ni rebotes que lleguen al handler.
+ */
+
+typedef enum _os_gpio_edge_e {
+    OS_GPIO_EDGE_FALLING,
+    OS_GPIO_EDGE_RISING,
+    OS_GPIO_EDGE_BOTH,
+} os_gpio_edge_e;
+
+/* Registro de un cambio de pin: puerto (bits 15-12), nivel después del cambio (bit 8) y máscara del pin (bits 7-0). */
+typedef uint16_t os_gpio_event_t;
+
+#define OS_GPIO_EVENT(port, pin, level) ((os_gpio_event_t) (((uint16_t) (port) << 12u) | \
+                                         ((level) ? 0x0100u : 0u) | (uint8_t) (pin)))
+#define OS_GPIO_EVENT_PORT(event)       ((gpio_port_t) ((event) >> 12u))
+#define OS_GPIO_EVENT_PIN(event)        ((uint8_t) ((event) & 0xFFu))
+#define OS_GPIO_EVENT_LEVEL(event)      ((uint8_t) (0u != ((event) & 0x0100u)))
+
+typedef void (*os_gpio_handler_t)(os_gpio_event_t event);
+
+/**
+ * @brief Registra el handler de un pin y activa su interrupción. El pin debe estar configurado como entrada.
+ *
+ * @param port Puerto del pin (GPIO_PORT_1 o GPIO_PORT_2).
+ * @param pin Máscara del pin, con un solo bit.
+ * @param edge Flanco que genera eventos.
+ * @param debounce_ticks Ticks que el nivel debe mantenerse antes de llamar al handler, o 0 para no filtrar.
+ * @param handler Función que recibe los eventos del pin. Se ejecuta en contexto de interrupción.
+ *
+ * @return OS_OK si registró el handler. Si el pin ya tenía handler, lo reemplaza.
+ *         OS_ERROR_INVALID_ARGUMENT si uno de los parámetros es incorrecto.
+ *         OS_ERROR_NO_SLOTS si ya hay OS_GPIO_IRQ_SLOTS pines registrados.
+ */
+error_id_e os_gpio_irq_attach(gpio_port_t port, uint8_t pin, os_gpio_edge_e edge, tick_type_t debounce_ticks,
+                              os_gpio_handler_t handler);
+
+/**
+ * @brief Desactiva la interrupción de un pin y libera su handler.
+ *
+ * @return OS_OK si liberó el handler.
+ *         OS_ERROR_INVALID_ARGUMENT si el pin no tiene handler.
+ */
+error_id_e os_gpio_irq_detach(gpio_port_t port, uint8_t pin);
+
+#endif /* OS_GPIO_IRQ_H_ */
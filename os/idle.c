@@ -0,0 +1,311 @@
+/*
+ * idle.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include <msp430.h>
+
+#include "idle.h"
+#include "systime.h"
+
+#include "os_private.h"
+
+#include "em.h"
+
+#ifdef OS_LOW_POWER_IDLE
+
+#ifdef OS_IDLE_TICKLESS
+/* Periodos de ACLK que mide idle_init para calibrar el VLO. */
+#define IDLE_CALIBRATION_PERIODS    (8u)
+
+volatile uint8_t idle_tickless;
+
+/* Cuentas de SMCLK por cada periodo de ACLK, a SYSTICK_CLOCK_HZ. */
+static uint16_t idle_smclk_per_aclk;
+
+#ifdef OS_DVFS
+/* Con OS_DVFS, SMCLK cambia de frecuencia después de la calibración. */
+#define IDLE_SMCLK_PER_ACLK     ((uint16_t) (((uint32_t) idle_smclk_per_aclk * SYSTICK_PERIOD_NOW) / SYSTICK_PERIOD))
+#else
+#define IDLE_SMCLK_PER_ACLK     (idle_smclk_per_aclk)
+#endif /* OS_DVFS */
+
+static void idle_tickless_sleep(tick_type_t ticks);
+static void idle_skip(tick_type_t ticks);
+#endif /* OS_IDLE_TICKLESS */
+
+static tick_type_t idle_next_event(void);
+
+void os_idle(void)
+{
+    tick_type_t ticks;
+    os_idle_mode_e mode = OS_IDLE_LPM0;
+#ifdef OS_IDLE_HOOKS
+    os_idle_mode_e allowed;
+#endif /* OS_IDLE_HOOKS */
+
+    EM_GLOBAL_INTERRUPT_DIS;
+
+    ticks = idle_next_event();
+
+#ifdef OS_IDLE_TICKLESS
+    if (OS_IDLE_TICKLESS_MIN_TICKS <= ticks)
+    {
+        mode = OS_IDLE_LPM3;
+    }
+#endif /* OS_IDLE_TICKLESS */
+
+#ifdef OS_IDLE_ALLOW_LPM4
+    if (OS_MAX_TICKS == ticks)
+    {
+        mode = OS_IDLE_LPM4;
+    }
+#endif /* OS_IDLE_ALLOW_LPM4 */
+
+    if (SYSTICK_CCTL & CCIFG)
+    {
+        // Hay un tick sin procesar. LPM0 deja que systick_isr lo procese antes de volver a evaluar.
+        mode = OS_IDLE_LPM0;
+    }
+
+    if ((UCA0STAT & UCBUSY) || (IE2 & UCA0TXIE))
+    {
+        // La UART transmite con SMCLK (hal_uart). En LPM3 o LPM4, SMCLK se detiene a la mitad del byte.
+        mode = OS_IDLE_LPM0;
+    }
+
+#ifdef OS_IDLE_HOOKS
+    allowed = os_idle_pre_sleep_hook(mode);
+    if (allowed < mode)
+    {
+        mode = allowed;
+    }
+#endif /* OS_IDLE_HOOKS */
+
+#ifdef OS_SUPERVISOR
+    if (OS_IDLE_LPM0 != mode)
+    {
+        supervisor_suspend();
+    }
+#endif /* OS_SUPERVISOR */
+
+#ifdef OS_DVFS
+    dvfs_idle_enter();
+#endif /* OS_DVFS */
+
+    // Las ISRs declaradas con OS_ISR limpian los bits de LPM del SR que recupera RETI, entonces el CPU continúa aquí
+    // después de la primera interrupción.
+    switch (mode)
+    {
+#ifdef OS_IDLE_TICKLESS
+    case OS_IDLE_LPM3:
+        idle_tickless_sleep(ticks);
+        break;
+#endif /* OS_IDLE_TICKLESS */
+    case OS_IDLE_LPM4:
+        __bis_SR_register(GIE | LPM4_bits);
+        break;
+    default:
+        __bis_SR_register(GIE | LPM0_bits);
+        break;
+    }
+
+    EM_GLOBAL_INTERRUPT_DIS;
+
+#ifdef OS_DVFS
+    dvfs_idle_exit();
+#endif /* OS_DVFS */
+
+#ifdef OS_SUPERVISOR
+    if (OS_IDLE_LPM0 != mode)
+    {
+        supervisor_resume();
+    }
+#endif /* OS_SUPERVISOR */
+
+#ifdef OS_IDLE_HOOKS
+    os_idle_post_sleep_hook(mode);
+#endif /* OS_IDLE_HOOKS */
+
+    if (os_switch_pending)
+    {
+        // Una tarea se activó mientras el timer contaba con ACLK (ver scheduler_preempt).
+        os_switch_pending = 0u;
+        scheduler_preempt();
+    }
+
+    EM_GLOBAL_INTERRUPT_EN;
+}
+
+/*
+ * Ticks hasta el siguiente evento del kernel, o OS_MAX_TICKS si no hay eventos. Se llama con interrupciones
+ * desactivadas.
+ */
+static tick_type_t idle_next_event(void)
+{
+    tick_type_t next = OS_MAX_TICKS;
+    task_id_t i;
+
+    alarms_next_event(&next);
+
+    i = NUM_TASK_MAX;
+    while (i--)
+    {
+        if (OS_TASK_STATE_WAIT == tasks[i].state)
+        {
+            OS_NEXT_EVENT(next, tasks[i].ticks_to_wait);
+        }
+    }
+
+#ifdef OS_SCHEDULE_TABLES
+    schedtable_next_event(&next);
+#endif /* OS_SCHEDULE_TABLES */
+
+#ifdef OS_SCHEDULER_EDF
+    scheduler_edf_next_event(&next);
+#endif /* OS_SCHEDULER_EDF */
+
+#ifdef OS_GPIO_IRQ
+    gpio_irq_next_event(&next);
+#endif /* OS_GPIO_IRQ */
+
+#ifdef OS_SUPERVISOR
+    supervisor_next_event(&next);
+#endif /* OS_SUPERVISOR */
+
+    return next;
+}
+
+#ifdef OS_IDLE_TICKLESS
+void idle_init(void)
+{
+    uint16_t first;
+    uint8_t i;
+
+    // ACLK = VLO. Medir su frecuencia con SMCLK, capturando flancos de ACLK (CCI0B) con el timer de systick.
+    BCSCTL3 = (BCSCTL3 & ~LFXT1S_3) | LFXT1S_2;
+
+    SYSTICK_CCTL = CM_1 | CCIS_1 | SCS | CAP;
+
+    while (0u == (SYSTICK_CCTL & CCIFG));
+    first = SYSTICK_CCR;
+
+    for (i = 0u; i < IDLE_CALIBRATION_PERIODS; i++)
+    {
+        SYSTICK_CCTL &= ~CCIFG;
+        while (0u == (SYSTICK_CCTL & CCIFG));
+    }
+
+    idle_smclk_per_aclk = (uint16_t) (SYSTICK_CCR - first) / IDLE_CALIBRATION_PERIODS;
+
+    // Regresar a modo de comparación. SYSTICK_TIMER_ENABLE programa el primer tick desde la cuenta actual.
+    SYSTICK_CCTL = 0u;
+    SYSTICK_CCR = SYSTICK_TAR;
+}
+
+/*
+ * Duerme en LPM3 hasta el tick del siguiente evento (ticks ticks después del último tick procesado), con el timer de
+ * systick en ACLK. Al despertar, regresa el timer a SMCLK con la misma fase de tick y procesa los ticks que pasaron.
+ */
+static void idle_tickless_sleep(tick_type_t ticks)
+{
+    uint32_t smclk_counts;
+    uint16_t aclk_counts;
+    uint16_t phase;
+    tick_type_t elapsed;
+    tick_type_t skipped;
+    uint16_t smclk_per_aclk = IDLE_SMCLK_PER_ACLK;
+
+    // Cuentas de SMCLK desde el último tick procesado.
+    phase = SYSTICK_PERIOD_NOW - (uint16_t) (SYSTICK_CCR - SYSTICK_TAR);
+
+    smclk_counts = ((uint32_t) ticks * SYSTICK_PERIOD_NOW) - phase;
+    aclk_counts = (smclk_counts / smclk_per_aclk < 0xFFFFu) ?
+                  (uint16_t) (smclk_counts / smclk_per_aclk) : 0xFFFFu;
+
+    idle_tickless = 1u;
+    SYSTICK_CTL = TASSEL_1 | MC_2 | TACLR;
+    SYSTICK_CCR = aclk_counts;
+    SYSTICK_CCTL &= ~CCIFG;
+
+    __bis_SR_register(GIE | LPM3_bits);
+
+    EM_GLOBAL_INTERRUPT_DIS;
+
+    // ACLK no está sincronizado con MCLK: repetir la lectura hasta obtener dos valores iguales.
+    do
+    {
+        aclk_counts = SYSTICK_TAR;
+    } while (aclk_counts != SYSTICK_TAR);
+
+    SYSTICK_CTL = TASSEL_2 | MC_2 | TACLR;
+    idle_tickless = 0u;
+
+    smclk_counts = ((uint32_t) aclk_counts * smclk_per_aclk) + phase;
+    elapsed = (tick_type_t) (smclk_counts / SYSTICK_PERIOD_NOW);
+    phase = (uint16_t) (smclk_counts % SYSTICK_PERIOD_NOW);
+
+    // El siguiente tick queda donde estaría si el timer hubiera seguido con SMCLK.
+    SYSTICK_CCR = SYSTICK_PERIOD_NOW - phase;
+    SYSTICK_CCTL &= ~CCIFG;
+
+    if (0u == elapsed)
+    {
+        return;
+    }
+
+    // Ningún contador llega a 0 antes del tick del evento, entonces esos ticks solo se descuentan. El tick del evento
+    // (y los ticks de más si el VLO despertó tarde) pasan por systick_handler.
+    skipped = ((elapsed < ticks) ? elapsed : ticks) - 1u;
+    idle_skip(skipped);
+
+    elapsed -= skipped;
+
+    // systick_handler avanza SYSTICK_CCR un periodo, entonces durante cada tick SYSTICK_CCR es el siguiente tick real
+    // (dvfs_tick puede cambiar el periodo en cualquiera de ellos).
+    while (elapsed--)
+    {
+        SYSTICK_CCR -= SYSTICK_PERIOD_NOW;
+        systick_handler();
+    }
+}
+
+/*
+ * Avanza ticks ticks el tiempo del sistema y los contadores del kernel, sin procesar eventos. ticks debe ser menor que
+ * el resultado de idle_next_event.
+ */
+static void idle_skip(tick_type_t ticks)
+{
+    task_id_t i;
+
+    os_tick_count += ticks;
+
+    i = NUM_TASK_MAX;
+    while (i--)
+    {
+        if (OS_TASK_STATE_WAIT == tasks[i].state)
+        {
+            tasks[i].ticks_to_wait -= ticks;
+        }
+    }
+
+#ifdef OS_SCHEDULE_TABLES
+    schedtable_skip(ticks);
+#endif /* OS_SCHEDULE_TABLES */
+
+#ifdef OS_SCHEDULER_EDF
+    scheduler_edf_skip(ticks);
+#endif /* OS_SCHEDULER_EDF */
+
+#ifdef OS_GPIO_IRQ
+    gpio_irq_skip(ticks);
+#endif /* OS_GPIO_IRQ */
+
+#ifdef OS_SUPERVISOR
+    supervisor_skip(ticks);
+#endif /* OS_SUPERVISOR */
+}
+#endif /* OS_IDLE_TICKLESS */
+
+#endif /* OS_LOW_POWER_IDLE */
@@ -0,0 +1,77 @@
+/*
+ * idle.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+
+#ifndef OS_IDLE_H_
+#define OS_IDLE_H_
+
+#include <stdint.h>
+
+#include "os.h"
+#include "os_config.h"
+
+/*
+ * Política de bajo consumo para la tarea idle. os_idle revisa cuántos ticks faltan para el siguiente evento del kernel
+ * (alarmas, timeouts de tareas en espera, tablas de activación, periodos y deadlines de EDF, debounce de GPIO) y elige
+ * el modo de bajo consumo más profundo que no lo retrasa:
+ *
+ * - OS_IDLE_LPM0 si el siguiente evento está a menos de OS_IDLE_TICKLESS_MIN_TICKS ticks. systick sigue con SMCLK.
+ * - OS_IDLE_LPM3 (con OS_IDLE_TICKLESS) si el siguiente evento está más lejos. El timer de systick cambia a ACLK (VLO)
+ *   y se programa para despertar en el tick del evento. Al despertar, os_idle regresa el timer a SMCLK y avanza el
+ *   tiempo del sistema los ticks que pasaron, con la fase del tick actual.
+ * - OS_IDLE_LPM4 (con OS_IDLE_ALLOW_LPM4) si ningún servicio del kernel tiene un evento programado. Solo una
+ *   interrupción externa (por ejemplo, de GPIO) despierta al CPU, y el tiempo del sistema no avanza mientras duerme.
+ *
+ * Mientras la UART transmite (UCBUSY, o UCA0TXIE con bytes pendientes en hal_uart), os_idle usa OS_IDLE_LPM0 para que
+ * SMCLK siga encendido.
+ *
+ * Cualquier ISR declarada con OS_ISR saca al CPU del modo de bajo consumo, y os_idle retorna para que la tarea idle
+ * vuelva a evaluar la política. Uso:
+ *
+ * void idle_task(void)
+ * {
+ *     while (1)
+ *     {
+ *         os_idle();
+ *     }
+ * }
+ */
+
+typedef enum _os_idle_mode_e {
+    OS_IDLE_LPM0,                       /* CPU apagado. DCO y SMCLK siguen encendidos. */
+    OS_IDLE_LPM3,                       /* Solo ACLK (VLO) encendido. systick cuenta con ACLK. */
+    OS_IDLE_LPM4,                       /* Todos los clocks apagados. */
+} os_idle_mode_e;
+
+/**
+ * @brief Duerme el CPU en el modo de bajo consumo que permite el siguiente evento del kernel, hasta la siguiente
+ * interrupción. Solo debe llamarse desde la tarea de menor prioridad.
+ */
+void os_idle(void);
+
+#ifdef OS_IDLE_HOOKS
+/**
+ * @brief Llamada por os_idle, con interrupciones desactivadas, antes de dormir. La aplicación debe definir esta función.
+ *
+ * Permite que los periféricos preparen el modo de bajo consumo o lo limiten. Por ejemplo, mientras un periférico de la
+ * aplicación usa SMCLK, debe retornar OS_IDLE_LPM0.
+ *
+ * @param mode Modo que eligió la política.
+ *
+ * @return El modo que usa os_idle. Si es más profundo que mode, os_idle usa mode.
+ */
+os_idle_mode_e os_idle_pre_sleep_hook(os_idle_mode_e mode);
+
+/**
+ * @brief Llamada por os_idle después de despertar, con interrupciones desactivadas y el timer de systick otra vez con
+ * SMCLK. La aplicación debe definir esta función.
+ *
+ * @param mode Modo del que despertó el CPU.
+ */
+void os_idle_post_sleep_hook(os_idle_mode_e mode);
+#endif /* OS_IDLE_HOOKS */
+
+#endif /* OS_IDLE_H_ */
@@ -0,0 +1,213 @@
+/*
+ * mailboxes.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include "mailboxes.h"
+#include "critical.h"
+
+#include "os_private.h"
+
+#ifdef OS_MAILBOXES
+
+typedef struct _mailbox_t {
+    uintptr_t data;                     /* Último elemento escrito: un puntero, o un valor del tamaño de un puntero. */
+    uint16_t seq;                       /* Número de secuencia de data. 0 si el mailbox no se ha escrito. */
+    uint8_t tasks_waiting;              /* Campo de bits con las tareas que esperan en os_mailbox_wait. */
+    uint8_t subscribers;                /* Campo de bits con las tareas suscritas. */
+} mailbox_t;
+
+static volatile mailbox_t mailboxes[OS_MAILBOX_COUNT];
+
+/*
+ * Escribe el elemento y despierta o activa a las tareas del mailbox. Se llama con interrupciones desactivadas. Regresa
+ * 1 si alguna tarea pasó a estado ready.
+ */
+static uint8_t mailbox_publish(mailbox_id_t id, const void * item)
+{
+    uint8_t woken = 0u;
+    uint8_t i;
+
+    mailboxes[id].data = (uintptr_t) item;
+
+    // 0 indica un mailbox sin escribir, entonces la secuencia salta de 0xFFFF a 1.
+    mailboxes[id].seq++;
+    if (0u == mailboxes[id].seq)
+    {
+        mailboxes[id].seq = 1u;
+    }
+
+    i = NUM_TASK_MAX;
+    while (i--)
+    {
+        if (mailboxes[id].tasks_waiting & (1u << i))
+        {
+            tasks[(task_id_t) i].state = OS_TASK_STATE_READY;
+            tasks[(task_id_t) i].ticks_to_wait = 0u;
+            woken = 1u;
+        }
+        else if (mailboxes[id].subscribers & (1u << i))
+        {
+            if (OS_TASK_STATE_SUSPENDED == tasks[i].state)
+            {
+                woken |= (OS_OK == task_activate((task_id_t) i));
+            }
+            else if (1u == tasks[i].activations && 1u < OS_TASK_ACTIVATIONS_MAX)
+            {
+                // La tarea está activa y pudo leer el mailbox antes de esta escritura: registrar una activación para
+                // que vuelva a ejecutarse. Una activación pendiente basta, porque la tarea lee el último elemento y no
+                // uno por escritura.
+                task_activate((task_id_t) i);
+            }
+        }
+    }
+
+    mailboxes[id].tasks_waiting = 0u;
+
+    return woken;
+}
+
+error_id_e os_mailbox_write(mailbox_id_t id, const void * item)
+{
+    if (OS_MAILBOX_COUNT <= id)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    os_enter_critical();
+
+    // os_exit_critical ejecuta el scheduler si alguna tarea pasó a estado ready.
+    if (mailbox_publish(id, item))
+    {
+        os_switch_pending = 1u;
+    }
+
+    os_exit_critical();
+
+    return OS_OK;
+}
+
+error_id_e os_mailbox_write_from_isr(mailbox_id_t id, const void * item)
+{
+    if (OS_MAILBOX_COUNT <= id)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (mailbox_publish(id, item))
+    {
+        os_switch_pending = 1u;
+    }
+
+    return OS_OK;
+}
+
+error_id_e os_mailbox_read(mailbox_id_t id, void * out_item, uint16_t * seq)
+{
+    error_id_e status = OS_OK;
+
+    if (OS_MAILBOX_COUNT <= id || 0 == out_item)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    // El elemento y su secuencia se leen juntos, sin una escritura en medio.
+    os_enter_critical();
+
+    if (0u == mailboxes[id].seq)
+    {
+        status = OS_ERROR_QUEUE_EMPTY;
+    }
+    else
+    {
+        *((uintptr_t *) out_item) = mailboxes[id].data;
+
+        if (0 != seq)
+        {
+            *seq = mailboxes[id].seq;
+        }
+    }
+
+    os_exit_critical();
+
+    return status;
+}
+
+error_id_e os_mailbox_wait(mailbox_id_t id, void * out_item, uint16_t * seq, tick_type_t ticks_to_wait)
+{
+    error_id_e status = OS_OK;
+
+    if (OS_MAILBOX_COUNT <= id || 0 == out_item || 0 == seq)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    os_enter_critical();
+
+    if ((0u == mailboxes[id].seq || *seq == mailboxes[id].seq) && 0u != ticks_to_wait)
+    {
+        if (!task_can_wait())
+        {
+            status = OS_ERROR_TASK_CLASS;
+        }
+        else
+        {
+            // Esperar la siguiente escritura o el timeout.
+            mailboxes[id].tasks_waiting |= (1u << current_task);
+            tasks[current_task].state = OS_TASK_STATE_WAIT;
+            tasks[current_task].ticks_to_wait = ticks_to_wait;
+
+            scheduler_run();
+
+            mailboxes[id].tasks_waiting &= ~(1u << current_task);
+        }
+    }
+
+    if (OS_OK == status)
+    {
+        if (0u == mailboxes[id].seq || *seq == mailboxes[id].seq)
+        {
+            status = OS_ERROR_QUEUE_EMPTY;
+        }
+        else
+        {
+            *((uintptr_t *) out_item) = mailboxes[id].data;
+            *seq = mailboxes[id].seq;
+        }
+    }
+
+    os_exit_critical();
+
+    return status;
+}
+
+error_id_e os_mailbox_subscribe(mailbox_id_t id, os_task_id_t task_id)
+{
+    if (OS_MAILBOX_COUNT <= id || NUM_TASK_MAX <= task_id)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    os_enter_critical();
+    mailboxes[id].subscribers |= (1u << task_id);
+    os_exit_critical();
+
+    return OS_OK;
+}
+
+error_id_e os_mailbox_unsubscribe(mailbox_id_t id, os_task_id_t task_id)
+{
+    if (OS_MAILBOX_COUNT <= id || NUM_TASK_MAX <= task_id)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    os_enter_critical();
+    mailboxes[id].subscribers &= ~(1u << task_id);
+    os_exit_critical();
+
+    return OS_OK;
+}
+
+#endif /* OS_MAILBOXES */
@@ -0,0 +1,127 @@
+/*
+ * mailboxes.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+
+#ifndef OS_MAILBOXES_H_
+#define OS_MAILBOXES_H_
+
+#include <stdint.h>
+
+#include "os.h"
+#include "os_config.h"
+#include "tasks.h"
+
+typedef uint8_t mailbox_id_t;
+
+/*
+ * Mailbox: un solo elemento que el escritor sobrescribe y que los lectores leen sin sacarlo, para datos donde solo
+ * importa el último valor (por ejemplo, la última muestra de un sensor). Cada escritura incrementa el número de
+ * secuencia del mailbox; un lector compara el número que recibió con el de su lectura anterior para saber si hay un
+ * valor nuevo o cuántos valores perdió.
+ *
+ * Topics: las tareas suscritas a un mailbox (os_mailbox_subscribe) se activan con cada escritura, y las tareas que
+ * esperan en os_mailbox_wait despiertan. Todas leen el mismo elemento, sin una copia por suscriptor. Por ejemplo:
+ *
+ * Igual que en las queues, el elemento es un puntero, o un valor del tamaño de un puntero (16 bits en el MSP430). El
+ * lector debe recibirlo en una variable de ese tamaño, por ejemplo un puntero o un uintptr_t.
+ *
+ * void filter_task(void)
+ * {
+ *     static uint16_t last_seq;
+ *     uintptr_t sample;
+ *
+ *     // Con ticks_to_wait = 0, solo lee si hay una muestra nueva desde la última activación.
+ *     if (OS_OK == os_mailbox_wait(MAILBOX_ADC, &sample, &last_seq, 0u))
+ *     {
+ *         ...
+ *     }
+ *     os_task_terminate();
+ * }
+ */
+
+/**
+ * @brief Escribe el elemento del mailbox, sobrescribiendo el anterior, e incrementa su número de secuencia.
+ *
+ * Despierta a las tareas que esperan en os_mailbox_wait y activa a las tareas suscritas. Una tarea suscrita que ya
+ * está activa registra una activación pendiente (máximo una), y vuelve a ejecutarse al terminar.
+ *
+ * @param id Identificador único del mailbox.
+ * @param item Elemento que será escrito en el mailbox.
+ *
+ * @return OS_OK si escribió el elemento.
+ *         OS_ERROR_INVALID_ARGUMENT si id no es un identificador válido.
+ */
+error_id_e os_mailbox_write(mailbox_id_t id, const void * item);
+
+/**
+ * @brief Escribe el elemento del mailbox desde una ISR (ver os_mailbox_write). El cambio de contexto ocurre cuando la
+ * ISR termina; la ISR debe estar declarada con OS_ISR en os/port.asm.
+ *
+ * @param id Identificador único del mailbox.
+ * @param item Elemento que será escrito en el mailbox.
+ *
+ * @return OS_OK si escribió el elemento.
+ *         OS_ERROR_INVALID_ARGUMENT si id no es un identificador válido.
+ */
+error_id_e os_mailbox_write_from_isr(mailbox_id_t id, const void * item);
+
+/**
+ * @brief Lee el elemento del mailbox sin sacarlo.
+ *
+ * @param id Identificador único del mailbox.
+ * @param out_item Espacio del tamaño de un puntero para recibir el elemento.
+ * @param seq Espacio para recibir el número de secuencia del elemento, o 0 si no hace falta. Nunca es 0 después de la
+ * primera escritura.
+ *
+ * @return OS_OK si leyó el elemento.
+ *         OS_ERROR_INVALID_ARGUMENT si uno de los parámetros es incorrecto.
+ *         OS_ERROR_QUEUE_EMPTY si el mailbox no se ha escrito.
+ */
+error_id_e os_mailbox_read(mailbox_id_t id, void * out_item, uint16_t * seq);
+
+/**
+ * @brief Lee el elemento del mailbox cuando su número de secuencia es distinto de *seq.
+ *
+ * Si el mailbox no tiene un elemento nuevo y ticks_to_wait no es 0, la tarea espera la siguiente escritura o el
+ * timeout. Con *seq = 0, cualquier elemento escrito es nuevo.
+ *
+ * @param id Identificador único del mailbox.
+ * @param out_item Espacio del tamaño de un puntero para recibir el elemento.
+ * @param seq Número de secuencia de la lectura anterior. Recibe el número de secuencia del elemento leído.
+ * @param ticks_to_wait Ticks que espera la tarea si el mailbox no tiene un elemento nuevo.
+ *
+ * @return OS_OK si leyó un elemento nuevo.
+ *         OS_ERROR_INVALID_ARGUMENT si uno de los parámetros es incorrecto.
+ *         OS_ERROR_QUEUE_EMPTY si no hay un elemento nuevo. Tarea puede haber esperado ticks_to_wait.
+ *         OS_ERROR_TASK_CLASS si hace falta esperar y la tarea actual no es una tarea extendida (o no hay tarea
+ *         actual, antes de os_init).
+ */
+error_id_e os_mailbox_wait(mailbox_id_t id, void * out_item, uint16_t * seq, tick_type_t ticks_to_wait);
+
+/**
+ * @brief Suscribe una tarea al mailbox. Cada escritura activa la tarea; si ya está activa, la tarea vuelve a
+ * ejecutarse al terminar (varias escrituras durante una ejecución registran una sola activación).
+ *
+ * @param id Identificador único del mailbox.
+ * @param task_id Identificador de la tarea.
+ *
+ * @return OS_OK si suscribió la tarea.
+ *         OS_ERROR_INVALID_ARGUMENT si uno de los parámetros es incorrecto.
+ */
+error_id_e os_mailbox_subscribe(mailbox_id_t id, os_task_id_t task_id);
+
+/**
+ * @brief Cancela la suscripción de una tarea al mailbox.
+ *
+ * @param id Identificador único del mailbox.
+ * @param task_id Identificador de la tarea.
+ *
+ * @return OS_OK si canceló la suscripción.
+ *         OS_ERROR_INVALID_ARGUMENT si uno de los parámetros es incorrecto.
+ */
+error_id_e os_mailbox_unsubscribe(mailbox_id_t id, os_task_id_t task_id);
+
+#endif /* OS_MAILBOXES_H_ */
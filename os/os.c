@@ -6,41 +6,82 @@
  */
 
 #include "os.h"
+#include "tasks.h"
+#include "profiler.h"
 
 #include "os_private.h"
 
+#include "em.h"
+
 #ifdef SYSTICK_BASE_TA0_0
 #define SYSTICK_TIMER_ENABLE    HAL_TIMER_A0_0_START(SYSTICK_PERIOD)
 #endif
 
-volatile uint16_t temp_register_value;
-volatile uint8_t scheduler_from_isr;
+#ifdef OS_SCHEDULER_EDF
+// La tarea a tiene precedencia sobre la tarea b si su deadline absoluto es más cercano. Con el mismo deadline (por
+// ejemplo, tareas sin periodo), tiene precedencia la de mayor prioridad.
+#define SCHEDULER_PRECEDES(a, b)    (tasks[(a)].ticks_to_deadline < tasks[(b)].ticks_to_deadline ||\
+                                     (tasks[(a)].ticks_to_deadline == tasks[(b)].ticks_to_deadline &&\
+                                      TASK_CONFIG(a).priority > TASK_CONFIG(b).priority))
+#elif defined(OS_PREEMPTION_THRESHOLD)
+// Una tarea que se está ejecutando o que fue desplazada compite con su umbral de desplazamiento. Con la misma prioridad
+// tiene precedencia la tarea con umbral, para que solo la desplace una tarea con prioridad mayor que el umbral.
+#define SCHEDULER_RAISED(task)      ((OS_TASK_STATE_RUN == tasks[(task)].state || tasks[(task)].preempted) &&\
+                                     TASK_CONFIG(task).threshold > TASK_CONFIG(task).priority)
+#define SCHEDULER_PRIORITY(task)    (SCHEDULER_RAISED(task) ? TASK_CONFIG(task).threshold : TASK_CONFIG(task).priority)
+#define SCHEDULER_PRECEDES(a, b)    (SCHEDULER_PRIORITY(a) > SCHEDULER_PRIORITY(b) ||\
+                                     (SCHEDULER_PRIORITY(a) == SCHEDULER_PRIORITY(b) &&\
+                                      SCHEDULER_RAISED(a) && !SCHEDULER_RAISED(b)))
+#else
+#define SCHEDULER_PRECEDES(a, b)    (TASK_CONFIG(a).priority > TASK_CONFIG(b).priority)
+#endif /* OS_SCHEDULER_EDF */
+
+// Mientras se ejecuta una tarea básica o corrutina, solo otra tarea sin contexto propio puede desplazarla.
+#define SCHEDULER_ELIGIBLE(task)    (0u == basic_task_depth || TASK_IS_STACKLESS(task))
+
+static uint8_t scheduler_dispatch_basic(task_id_t task_id);
+
+#ifdef OS_ROUND_ROBIN
+static task_id_t scheduler_rr_select(task_id_t top_task_id);
+static void scheduler_rr_start(task_id_t task_id);
+#endif /* OS_ROUND_ROBIN */
+
+#ifdef OS_SCHEDULER_EDF
+static void scheduler_deadline_miss(task_id_t task_id);
+#endif /* OS_SCHEDULER_EDF */
+
+volatile uint8_t os_switch_pending;
+
+volatile uint8_t basic_task_depth;
 
 error_id_e os_init(void)
 {
     volatile uint8_t i;
 
+#ifdef OS_STATIC_CONFIG
+    // Solo el estado mutable de tareas y alarmas está en RAM. Sus atributos están en las tablas de os_gen_cfg.c.
+    tasks_init();
+    alarms_init();
+#endif /* OS_STATIC_CONFIG */
+
+    // El contexto inicial (PC y SP) de cada tarea extendida se carga en os_task_create (o tasks_init).
     i = NUM_TASK_MAX;
     while (i--)
     {
-        // Cargar valor inicial de PC para cada tarea.
-        tasks[i].stack[TASK_STACK_SIZE - 1u] = (uint16_t) tasks[i].task_function;
-
         // Inicar tareas con autostart.
-        if (OS_TASK_STATE_SUSPENDED == tasks[i].state && tasks[i].autostart)
+        if (OS_TASK_STATE_SUSPENDED == tasks[i].state && TASK_CONFIG(i).autostart)
         {
-            tasks[i].state = OS_TASK_STATE_READY;
-            num_active_tasks++;
+            task_activate(i);
         }
     }
 
-    // TODO: Pruebas temporales para manejo de stack. Hace falta integrar esto con el servicio create_task.
-    // 40 bytes de stack por tarea.
-    tasks[0].stack[TASK_STACK_SIZE - 2u] = 0x03FE;
-    tasks[1].stack[TASK_STACK_SIZE - 2u] = 0x03D6;
-    tasks[2].stack[TASK_STACK_SIZE - 2u] = 0x03AE;
-    tasks[3].stack[TASK_STACK_SIZE - 2u] = 0x0386;
+#ifdef OS_IDLE_TICKLESS
+    idle_init();
+#endif /* OS_IDLE_TICKLESS */
 
+#ifdef OS_SUPERVISOR
+    supervisor_init();
+#endif /* OS_SUPERVISOR */
 
     // Iniciar timer para alarmas.
     SYSTICK_TIMER_ENABLE;
@@ -50,42 +91,384 @@ error_id_e os_init(void)
 
 void scheduler_run(void)
 {
-    volatile uint8_t top_priority = 0u;
-    volatile uint8_t top_priority_task_id = OS_TASK_ID_MAX;
-    volatile task_id_t i;
+    task_id_t top_priority_task_id;
+    task_id_t i;
+    volatile uint16_t * save_context;
+    critical_state_t critical;
+    uint16_t interrupt_state;
 
-    if (0u != num_active_tasks)
+    // systick_handler y os_task_activate_from_isr modifican el estado de las tareas.
+    interrupt_state = __get_SR_register() & GIE;
+    EM_GLOBAL_INTERRUPT_DIS;
+    PROFILER_START(OS_PROFILER_KIND_IRQ);
+
+    do
     {
-        i = NUM_TASK_MAX;
-        while (i--)
+        top_priority_task_id = OS_TASK_ID_MAX;
+
+        if (0u != num_active_tasks)
         {
-            if (OS_TASK_STATE_READY == tasks[i].state && top_priority <= tasks[i].priority)
+            i = NUM_TASK_MAX;
+            while (i--)
             {
-                top_priority = tasks[i].priority;
-                top_priority_task_id = i;
+                if (OS_TASK_STATE_READY == tasks[i].state && SCHEDULER_ELIGIBLE(i) &&
+                    (OS_TASK_ID_MAX == top_priority_task_id || !SCHEDULER_PRECEDES(top_priority_task_id, i)))
+                {
+                    top_priority_task_id = i;
+                }
             }
+
+#ifdef OS_ROUND_ROBIN
+            top_priority_task_id = scheduler_rr_select(top_priority_task_id);
+#endif /* OS_ROUND_ROBIN */
         }
+    } while (scheduler_dispatch_basic(top_priority_task_id));
+
+    if (0u != basic_task_depth)
+    {
+        // Una tarea básica sigue en ejecución y ninguna otra tarea básica puede desplazarla. Continuar con la tarea
+        // básica actual; las tareas extendidas esperan a que terminen todas las tareas básicas anidadas.
+        top_priority_task_id = current_task;
     }
 
     if (OS_TASK_ID_MAX != top_priority_task_id)
     {
         tasks[top_priority_task_id].state = OS_TASK_STATE_RUN;
+#ifdef OS_PREEMPTION_THRESHOLD
+        tasks[top_priority_task_id].preempted = 0u;
+#endif /* OS_PREEMPTION_THRESHOLD */
+#ifdef OS_ROUND_ROBIN
+        scheduler_rr_start(top_priority_task_id);
+#endif /* OS_ROUND_ROBIN */
 
         if (current_task != top_priority_task_id)
         {
-            if (OS_TASK_ID_MAX != current_task)
+            // El contexto de una tarea que terminó no debe guardarse, porque sobreescribiría su contexto inicial.
+            save_context = (OS_TASK_ID_MAX != current_task) ? TASK_CONTEXT(current_task) : 0;
+
+            current_task = top_priority_task_id;
+
+            // Cuando otra llamada al scheduler vuelva a elegir a la tarea guardada, port_context_switch retorna aquí.
+            critical = critical_suspend();
+            port_context_switch(save_context, TASK_CONTEXT(current_task));
+            critical_resume(critical);
+        }
+    }
+
+    if (interrupt_state)
+    {
+        PROFILER_STOP(OS_PROFILER_KIND_IRQ);
+        EM_GLOBAL_INTERRUPT_EN;
+    }
+}
+
+void scheduler_preempt(void)
+{
+    if (0u != os_critical.nesting || 0u != os_critical.tick_nesting)
+    {
+        // La tarea interrumpida está en una sección crítica. os_exit_critical u os_exit_tick_critical cambian de
+        // tarea cuando termina.
+        os_switch_pending = 1u;
+        return;
+    }
+
+#ifdef OS_IDLE_TICKLESS
+    if (idle_tickless)
+    {
+        // La tarea idle debe regresar el timer de systick a SMCLK antes de ceder el CPU. os_idle cambia de tarea al
+        // despertar.
+        os_switch_pending = 1u;
+        return;
+    }
+#endif /* OS_IDLE_TICKLESS */
+
+#ifdef OS_DVFS
+    // Si la ISR interrumpió el sueño de os_idle, el tiempo dormido termina aquí: la tarea que se activó se ejecuta
+    // antes de que la tarea idle vuelva a os_idle, y ese tiempo es carga del CPU.
+    dvfs_idle_exit();
+#endif /* OS_DVFS */
+
+    PROFILER_START(OS_PROFILER_KIND_IRQ);
+
+    if (OS_TASK_ID_MAX != current_task && OS_TASK_STATE_RUN == tasks[current_task].state)
+    {
+        tasks[current_task].state = OS_TASK_STATE_READY;
+#ifdef OS_PREEMPTION_THRESHOLD
+        tasks[current_task].preempted = 1u;
+#endif /* OS_PREEMPTION_THRESHOLD */
+    }
+
+    scheduler_run();
+
+    PROFILER_STOP(OS_PROFILER_KIND_IRQ);
+}
+
+static uint8_t scheduler_dispatch_basic(task_id_t task_id)
+{
+    task_id_t preempted_task;
+    critical_state_t critical;
+    uint16_t interrupt_state;
+
+    if (OS_TASK_ID_MAX == task_id || !TASK_IS_STACKLESS(task_id) || current_task == task_id ||
+        (0u != basic_task_depth && !SCHEDULER_PRECEDES(task_id, current_task)))
+    {
+        return 0u;
+    }
+
+    // Ejecutar la tarea básica como una llamada anidada, sobre el stack del contexto actual. La tarea no necesita
+    // guardar contexto porque siempre termina antes de que continúe la tarea desplazada.
+    preempted_task = current_task;
+    current_task = task_id;
+    tasks[task_id].state = OS_TASK_STATE_RUN;
+#ifdef OS_ROUND_ROBIN
+    scheduler_rr_start(task_id);
+#endif /* OS_ROUND_ROBIN */
+    basic_task_depth++;
+
+    interrupt_state = __get_SR_register() & GIE;
+    critical = critical_suspend();
+
+    EM_GLOBAL_INTERRUPT_EN;
+    TASK_CONFIG(task_id).task_function();
+    EM_GLOBAL_INTERRUPT_DIS;
+
+    critical_resume(critical);
+
+    if (OS_TASK_STATE_RUN == tasks[task_id].state)
+    {
+        // La tarea retornó sin llamar a os_task_terminate.
+        task_end(task_id);
+    }
+
+    basic_task_depth--;
+    current_task = preempted_task;
+
+    if (interrupt_state)
+    {
+        EM_GLOBAL_INTERRUPT_EN;
+    }
+
+    return 1u;
+}
+
+#ifdef OS_ROUND_ROBIN
+// Tarea lista que puede tomar el turno de round-robin frente a top_task_id: misma prioridad y sin que top_task_id la
+// preceda.
+#define SCHEDULER_RR_PEER(task, top_task)   (OS_TASK_STATE_READY == tasks[task].state && SCHEDULER_ELIGIBLE(task) &&\
+                                             TASK_CONFIG(task).priority == TASK_CONFIG(top_task).priority &&\
+                                             !SCHEDULER_PRECEDES(top_task, task))
+
+/*
+ * Elige entre las tareas listas con la misma prioridad que top_task_id. Cada prioridad recuerda qué tarea tiene el
+ * turno (rr_turn), aunque otra tarea de mayor prioridad la desplace o la tarea termine: el turno sigue con esa tarea
+ * mientras esté lista y le quede time slice, y después pasa a la siguiente tarea lista en orden circular.
+ */
+static task_id_t scheduler_rr_select(task_id_t top_task_id)
+{
+    task_id_t task_id = OS_TASK_ID_MAX;
+    task_id_t i;
+
+    if (OS_TASK_ID_MAX == top_task_id)
+    {
+        return top_task_id;
+    }
+
+    i = NUM_TASK_MAX;
+    while (i--)
+    {
+        if (tasks[i].rr_turn && TASK_CONFIG(i).priority == TASK_CONFIG(top_task_id).priority)
+        {
+            task_id = i;
+        }
+    }
+
+    if (OS_TASK_ID_MAX == task_id)
+    {
+        // Nadie tiene el turno de esta prioridad: gana la tarea de menor ID.
+        return top_task_id;
+    }
+
+    if (0u == tasks[task_id].rr_ticks)
+    {
+        // Expiró el time slice: el turno pasa a la siguiente tarea, o regresa a la misma si es la única lista.
+        task_id++;
+    }
+
+    i = NUM_TASK_MAX;
+    while (i--)
+    {
+        if (NUM_TASK_MAX <= task_id)
+        {
+            task_id = 0u;
+        }
+
+        if (SCHEDULER_RR_PEER(task_id, top_task_id))
+        {
+            return task_id;
+        }
+
+        task_id++;
+    }
+
+    return top_task_id;
+}
+
+/*
+ * Da el turno de round-robin de su prioridad a la tarea que comienza a ejecutarse. Un turno nuevo, o el de una tarea
+ * cuyo time slice expiró, comienza con un time slice completo.
+ */
+static void scheduler_rr_start(task_id_t task_id)
+{
+    task_id_t i;
+
+    if (tasks[task_id].rr_turn && 0u != tasks[task_id].rr_ticks)
+    {
+        return;
+    }
+
+    i = NUM_TASK_MAX;
+    while (i--)
+    {
+        if (TASK_CONFIG(i).priority == TASK_CONFIG(task_id).priority)
+        {
+            tasks[i].rr_turn = 0u;
+        }
+    }
+
+    tasks[task_id].rr_turn = 1u;
+    tasks[task_id].rr_ticks = OS_RR_TIME_SLICE_TICKS;
+}
+
+uint8_t scheduler_rr_tick(void)
+{
+    task_id_t i;
+
+    if (OS_TASK_ID_MAX == current_task || !tasks[current_task].rr_turn || 0u == tasks[current_task].rr_ticks)
+    {
+        return 0u;
+    }
+
+    if (0u != (--tasks[current_task].rr_ticks))
+    {
+        return 0u;
+    }
+
+    // Solo hace falta cambiar de tarea si otra tarea lista tiene la misma prioridad que la tarea actual.
+    i = NUM_TASK_MAX;
+    while (i--)
+    {
+        if (i != current_task && OS_TASK_STATE_READY == tasks[i].state &&
+            TASK_CONFIG(current_task).priority == TASK_CONFIG(i).priority)
+        {
+            return 1u;
+        }
+    }
+
+    // Sin otra tarea lista, la tarea actual comienza otro time slice.
+    tasks[current_task].rr_ticks = OS_RR_TIME_SLICE_TICKS;
+
+    return 0u;
+}
+#endif /* OS_ROUND_ROBIN */
+
+#ifdef OS_SCHEDULER_EDF
+uint8_t scheduler_edf_tick(void)
+{
+    uint8_t task_released = 0u;
+    task_id_t i;
+
+    i = NUM_TASK_MAX;
+    while (i--)
+    {
+        if (0u == TASK_CONFIG(i).period)
+        {
+            continue;
+        }
+
+        if (0u == (--tasks[i].ticks_to_release))
+        {
+            // Inicio de un nuevo periodo.
+            tasks[i].ticks_to_release = TASK_CONFIG(i).period;
+
+            if (OS_TASK_STATE_SUSPENDED == tasks[i].state)
             {
-                SAVE_CONTEXT();
+                task_activate(i);
+                task_released = 1u;
+            }
+            else if (0u != tasks[i].ticks_to_deadline)
+            {
+                // La tarea sigue activa desde el periodo anterior y su deadline no había sido registrado como perdido.
+                scheduler_deadline_miss(i);
             }
 
-            current_task = top_priority_task_id;
-            current_task_stack = (uint16_t *) tasks[current_task].stack;
+            tasks[i].ticks_to_deadline = TASK_CONFIG(i).deadline;
+        }
+        else if (OS_TASK_STATE_SUSPENDED != tasks[i].state && 0u != tasks[i].ticks_to_deadline &&
+                 0u == (--tasks[i].ticks_to_deadline))
+        {
+            // La tarea no terminó antes de su deadline. Con ticks_to_deadline en 0 queda como la más urgente.
+            scheduler_deadline_miss(i);
+        }
+    }
+
+    return task_released;
+}
 
-            // Recuperar 3 espacios de 16 bits usados por variables locales y direccion de retorno.
-            __asm volatile (" ADD #6, SP");
+static void scheduler_deadline_miss(task_id_t task_id)
+{
+    if (0xFFu != tasks[task_id].deadline_misses)
+    {
+        tasks[task_id].deadline_misses++;
+    }
+
+#ifdef OS_DEADLINE_MISS_HOOK
+    os_deadline_miss_hook((os_task_id_t) task_id);
+#endif /* OS_DEADLINE_MISS_HOOK */
+}
+
+#ifdef OS_LOW_POWER_IDLE
+void scheduler_edf_next_event(tick_type_t * next)
+{
+    task_id_t i;
 
-            RESTORE_CONTEXT();
+    i = NUM_TASK_MAX;
+    while (i--)
+    {
+        if (0u == TASK_CONFIG(i).period)
+        {
+            continue;
+        }
+
+        OS_NEXT_EVENT(*next, tasks[i].ticks_to_release);
+
+        if (OS_TASK_STATE_SUSPENDED != tasks[i].state)
+        {
+            OS_NEXT_EVENT(*next, tasks[i].ticks_to_deadline);
         }
     }
 }
 
+#ifdef OS_IDLE_TICKLESS
+void scheduler_edf_skip(tick_type_t ticks)
+{
+    task_id_t i;
+
+    i = NUM_TASK_MAX;
+    while (i--)
+    {
+        if (0u == TASK_CONFIG(i).period)
+        {
+            continue;
+        }
+
+        tasks[i].ticks_to_release -= ticks;
+
+        if (OS_TASK_STATE_SUSPENDED != tasks[i].state && 0u != tasks[i].ticks_to_deadline)
+        {
+            tasks[i].ticks_to_deadline -= ticks;
+        }
+    }
+}
+#endif /* OS_IDLE_TICKLESS */
+#endif /* OS_LOW_POWER_IDLE */
+#endif /* OS_SCHEDULER_EDF */
@@ -19,12 +19,16 @@
 #define OS_MAX_TICKS    ((tick_type_t) 0xFFFFu)
 
 typedef enum _error_id_e {
-    OS_OK,                          /* Ningn error, funcin complet con xito. */
-    OS_ERROR_INVALID_ARGUMENT,      /* Uno o varios de los argumentos de una funcin son no-vlidos. */
-    OS_ERROR_MAX_CREATED_TASKS,     /* El OS alcanz el lmite de tareas creadas. No se puede crear una nueva tarea. */
-    OS_ERROR_MAX_ACTIVE_TASKS,      /* El OS ya tiene el mximo nmero de tareas activas. */
+    OS_OK,                          /* Ningún error, función completó con éxito. */
+    OS_ERROR_INVALID_ARGUMENT,      /* Uno o varios de los argumentos de una función son no-válidos. */
+    OS_ERROR_MAX_CREATED_TASKS,     /* El OS alcanzó el límite de tareas creadas. No se puede crear una nueva tarea. */
+    OS_ERROR_MAX_ACTIVE_TASKS,      /* El OS ya tiene el máximo número de tareas activas. */
     OS_ERROR_QUEUE_EMPTY,           /* No hay elementos para leer en la queue. */
-    OS_ERROR_QUEUE_FULL,            /* La queue est llena, no puede agregar un nuevo elemento. */
+    OS_ERROR_QUEUE_FULL,            /* La queue está llena, no puede agregar un nuevo elemento. */
+    OS_ERROR_MAX_ACTIVATIONS,       /* La tarea ya tiene el máximo de activaciones registradas (OS_TASK_ACTIVATIONS_MAX). */
+    OS_ERROR_TASK_CLASS,            /* El servicio no está disponible para la clase de la tarea actual (por ejemplo, esperar en una tarea básica). */
+    OS_ERROR_NO_SLOTS,              /* No hay espacio libre en una tabla de tamaño fijo (por ejemplo, handlers de GPIO). */
+    OS_PENDING,                     /* La operación no terminó, la corrutina debe retornar al scheduler y esperar. */
 } error_id_e;
 
 typedef uint16_t tick_type_t;
@@ -32,12 +36,12 @@ typedef uint16_t tick_type_t;
 /**
  * @brief Inicializa el sistema operativo y ejecuta el scheduler por primera vez.
  *
- * @return OS_OK si inicializ OS sin errores.
+ * @return OS_OK si inicializó OS sin errores.
  */
 error_id_e os_init(void);
 
 /**
- * @brief Comienza la ejecucin del scheduler del OS. Esta funcin no retorna.
+ * @brief Comienza la ejecución del scheduler del OS. Esta función no retorna.
  */
 void scheduler_run(void);
 
@@ -0,0 +1,133 @@
+;
+; port.asm
+;
+;  Created on: Oct 18, 2026
+;      Author: Fernando Mendoza V.
+;
+; Cambio de contexto y epílogo común de las ISRs. Todo el código que manipula SP o depende del orden de los registros
+; está en este archivo, entonces el código en C puede compilarse con cualquier nivel de optimización.
+;
+; Convención de llamada del compilador (MSP430, cl430): R12-R15 son argumentos y R11-R15 no se preservan en una
+; llamada; R4-R10 sí se preservan.
+
+            .cdecls C, NOLIST, "msp430.h"
+
+            ; Funciones opcionales de os_config.h que agregan ISRs.
+            .cdecls C, NOLIST
+%{
+#include "os_config.h"
+#ifdef OS_GPIO_IRQ
+#define PORT_GPIO_IRQ   1
+#else
+#define PORT_GPIO_IRQ   0
+#endif
+#ifdef OS_LOW_POWER_IDLE
+#define PORT_LOW_POWER_IDLE 1
+#else
+#define PORT_LOW_POWER_IDLE 0
+#endif
+%}
+
+            .ref    os_switch_pending
+            .ref    scheduler_preempt
+
+            .def    port_context_switch
+            .def    os_isr_exit
+
+;
+; OS_ISR vector, entry, handler
+;
+; Declara una ISR que puede activar tareas. entry es la rutina que se instala en el vector: guarda R11-R15, llama a
+; handler (una función normal de C, sin __interrupt ni #pragma vector) y regresa a través de os_isr_exit. Para agregar
+; una ISR de la aplicación, escribir el handler en C y agregar una línea OS_ISR al final de este archivo.
+;
+OS_ISR      .macro  vector, entry, handler
+            .ref    handler
+            .def    entry
+            .text
+            .align  2
+:entry:     .asmfunc
+            PUSH    R15
+            PUSH    R14
+            PUSH    R13
+            PUSH    R12
+            PUSH    R11
+            CALL    #handler
+            BR      #os_isr_exit
+            .endasmfunc
+            .intvec ":vector:", entry
+            .endm
+
+            .text
+            .align  2
+
+;
+; Epílogo común de las ISRs declaradas con OS_ISR. Si la ISR activó una tarea (os_switch_pending), ejecuta el
+; scheduler sobre el stack de la tarea interrumpida, con R11-R15 guardados. Si el scheduler cambia de tarea, la tarea
+; interrumpida continúa aquí cuando vuelve a ser elegida, y RETI recupera su SR y PC. Con OS_LOW_POWER_IDLE, limpia los
+; bits de LPM del SR guardado para que os_idle continúe después de cualquier ISR.
+;
+os_isr_exit: .asmfunc
+            TST.B   &os_switch_pending
+            JZ      isr_exit_return
+            MOV.B   #0, &os_switch_pending
+            CALL    #scheduler_preempt
+isr_exit_return:
+            POP     R11
+            POP     R12
+            POP     R13
+            POP     R14
+            POP     R15
+            .if     PORT_LOW_POWER_IDLE
+            BIC     #LPM4_bits, 0(SP)
+            .endif
+            RETI
+            .endasmfunc
+
+;
+; void port_context_switch(volatile uint16_t * save_context, volatile uint16_t * restore_context)
+;
+; R12 = save_context (puede ser 0), R13 = restore_context. Offsets en bytes de TASK_CONTEXT_* (os_private.h):
+; R4-R10 = 0-12, SR = 14, SP = 16, PC = 18.
+;
+port_context_switch: .asmfunc
+            PUSH    SR
+            DINT
+            NOP
+            TST     R12
+            JZ      context_restore
+            MOV     R4, 0(R12)
+            MOV     R5, 2(R12)
+            MOV     R6, 4(R12)
+            MOV     R7, 6(R12)
+            MOV     R8, 8(R12)
+            MOV     R9, 10(R12)
+            MOV     R10, 12(R12)
+            MOV     @SP+, 14(R12)           ; SR de la tarea, incluyendo GIE.
+            MOV     @SP+, 18(R12)           ; Dirección de retorno de port_context_switch.
+            MOV     SP, 16(R12)
+context_restore:
+            MOV     0(R13), R4
+            MOV     2(R13), R5
+            MOV     4(R13), R6
+            MOV     6(R13), R7
+            MOV     8(R13), R8
+            MOV     10(R13), R9
+            MOV     12(R13), R10
+            MOV     16(R13), SP
+            PUSH    18(R13)
+            PUSH    14(R13)
+            RETI                            ; Recupera SR y PC en una sola instrucción.
+            .endasmfunc
+
+;
+; ISRs que pueden activar tareas.
+;
+            OS_ISR  .int09, systick_isr, systick_handler     ; TIMER0_A0 (SYSTICK_BASE_TA0_0)
+
+            .if     PORT_GPIO_IRQ
+            OS_ISR  .int02, gpio_port1_isr, gpio_port1_handler
+            OS_ISR  .int03, gpio_port2_isr, gpio_port2_handler
+            .endif
+
+            .end
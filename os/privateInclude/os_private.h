@@ -11,76 +11,28 @@
 #include <stdint.h>
 
 #include "os_config.h"
+#include "os.h"
 
-// @brief Guarda todos los registros del contexto de la tarea actual, excepto R4.
-// Recuperar R0 (PC) del stack.
-// Mover puntero de stack de la tarea a R4.
-// Almacenar valor original de R0 en stack de la tarea.
-// Almacenar R1 -> R15 en stack de la tarea.
-#define SAVE_CONTEXT() ({\
-    __asm volatile (" MOV &current_task_stack, R4");\
-    __asm volatile (" MOV 4(SP), 0(R4)");\
-    __asm volatile (" SUB #2, R4");\
-    __asm volatile (" MOV SP, 0(R4)");\
-    __asm volatile (" ADD #6, 0(R4)");\
-    __asm volatile (" SUB #2, R4");\
-    __asm volatile (" MOV R2, 0(R4)");\
-    __asm volatile (" SUB #2, R4");\
-    __asm volatile (" MOV R3, 0(R4)");\
-    __asm volatile (" SUB #4, R4");\
-    __asm volatile (" MOV R5, 0(R4)");\
-    __asm volatile (" SUB #2, R4");\
-    __asm volatile (" MOV R6, 0(R4)");\
-    __asm volatile (" SUB #2, R4");\
-    __asm volatile (" MOV R7, 0(R4)");\
-    __asm volatile (" SUB #2, R4");\
-    __asm volatile (" MOV R8, 0(R4)");\
-    __asm volatile (" SUB #2, R4");\
-    __asm volatile (" MOV R9, 0(R4)");\
-    __asm volatile (" SUB #2, R4");\
-    __asm volatile (" MOV R10, 0(R4)");\
-    __asm volatile (" SUB #2, R4");\
-    __asm volatile (" MOV R11, 0(R4)");\
-    __asm volatile (" SUB #2, R4");\
-    __asm volatile (" MOV R12, 0(R4)");\
-    __asm volatile (" SUB #2, R4");\
-    __asm volatile (" MOV R13, 0(R4)");\
-    __asm volatile (" SUB #2, R4");\
-    __asm volatile (" MOV R14, 0(R4)");\
-    __asm volatile (" SUB #2, R4");\
-    __asm volatile (" MOV R15, 0(R4)");\
-    __asm volatile (" MOV R4, &current_task_stack");\
-})
-
-
-// @brief Recupera todos los registros de la tarea, excepto R4.
-// Mover puntero de stack de la tarea a R4.
-// Recuperar valor original de R15 -> R5.
-// Ignorar valor original de R4.
-// Recuperar valor original de R3 -> R0 (PC).
-#define RESTORE_CONTEXT() ({\
-    __asm volatile (" MOV &current_task_stack, R4");\
-    __asm volatile (" MOV @R4+, R15");\
-    __asm volatile (" MOV @R4+, R14");\
-    __asm volatile (" MOV @R4+, R13");\
-    __asm volatile (" MOV @R4+, R12");\
-    __asm volatile (" MOV @R4+, R11");\
-    __asm volatile (" MOV @R4+, R10");\
-    __asm volatile (" MOV @R4+, R9");\
-    __asm volatile (" MOV @R4+, R8");\
-    __asm volatile (" MOV @R4+, R7");\
-    __asm volatile (" MOV @R4+, R6");\
-    __asm volatile (" MOV @R4+, R5");\
-    __asm volatile (" ADD #2, R4");\
-    __asm volatile (" MOV @R4+, R3");\
-    __asm volatile (" ADD #2, R4");\
-    __asm volatile (" BIC #16, 0(R4)");\
-    __asm volatile (" MOV @R4+, SR");\
-    __asm volatile (" MOV @R4+, SP");\
-    __asm volatile (" MOV R4, &current_task_stack");\
-    __asm volatile (" EINT");\
-    __asm volatile (" MOV @R4, PC");\
-})
+// Timer de systick: registro de comparación y contador. El contador corre en modo continuo, y systick_isr avanza el
+// registro de comparación SYSTICK_PERIOD cuentas en cada tick. El vector (.int09) se declara en os/port.asm.
+#ifdef SYSTICK_BASE_TA0_0
+#define SYSTICK_CTL     TA0CTL
+#define SYSTICK_CCR     TA0CCR0
+#define SYSTICK_CCTL    TA0CCTL0
+#define SYSTICK_TAR     TA0R
+#endif /* SYSTICK_BASE_TA0_0 */
+
+// Cuentas del timer por tick a la frecuencia actual. Con OS_DVFS cambian con la frecuencia del DCO, y
+// SYSTICK_COUNTS_TO_TIMESTAMP convierte cuentas a la frecuencia actual en cuentas de SYSTICK_CLOCK_HZ.
+#ifdef OS_DVFS
+extern volatile uint16_t dvfs_systick_period;
+#define SYSTICK_PERIOD_NOW  (dvfs_systick_period)
+#define SYSTICK_COUNTS_TO_TIMESTAMP(counts) ((SYSTICK_PERIOD == dvfs_systick_period) ? (uint32_t) (counts) : \
+                                             ((uint32_t) (counts) * SYSTICK_PERIOD) / dvfs_systick_period)
+#else
+#define SYSTICK_PERIOD_NOW  (SYSTICK_PERIOD)
+#define SYSTICK_COUNTS_TO_TIMESTAMP(counts) ((uint32_t) (counts))
+#endif /* OS_DVFS */
 
 typedef enum _task_state_e {
     OS_TASK_STATE_EMPTY,
@@ -90,27 +42,446 @@ typedef enum _task_state_e {
     OS_TASK_STATE_RUN,
 } task_state_e;
 
+typedef enum _task_class_e {
+    OS_TASK_CLASS_EXTENDED,             /* Tiene stack y contexto propios, puede esperar (por ejemplo, en queues). */
+    OS_TASK_CLASS_BASIC,                /* Se ejecuta hasta terminar sobre el stack compartido, sin contexto propio. */
+    OS_TASK_CLASS_COROUTINE,            /* Igual que una tarea básica, pero retorna al scheduler en sus puntos de espera. */
+} task_class_e;
+
 typedef uint8_t task_id_t;
 typedef void (*task_function_t)(void);
 
+/*
+ * Atributos de una tarea que no cambian durante la ejecución. Con OS_STATIC_CONFIG están en la tabla const
+ * os_task_config (flash), generada por tools/osgen.py. Sin OS_STATIC_CONFIG son parte de task_t, y os_task_create*
+ * los registra.
+ */
+#define TASK_CONFIG_FIELDS \
+    task_function_t task_function;      /* Dirección de inicio de la tarea. */\
+    uint8_t priority;                   /* Prioridad, en rango 0-255. */\
+    uint8_t autostart;                  /* Si es TRUE, la inicialización del sistema activa la tarea automáticamente. */\
+    uint8_t task_class;                 /* Uno de OS_TASK_CLASS_*. */\
+    uint8_t context_id;                 /* Índice del contexto en task_contexts. Solo válido para tareas extendidas. */
+
+#ifdef OS_SCHEDULER_EDF
+#define TASK_CONFIG_EDF_FIELDS \
+    uint16_t period;                    /* Periodo de activación en ticks. Es 0 si la tarea no es periódica. */\
+    uint16_t deadline;                  /* Deadline relativo al inicio de cada periodo, en ticks. */
+#else
+#define TASK_CONFIG_EDF_FIELDS
+#endif /* OS_SCHEDULER_EDF */
+
+#ifdef OS_PREEMPTION_THRESHOLD
+#define TASK_CONFIG_THRESHOLD_FIELDS \
+    uint8_t threshold;                  /* Umbral de desplazamiento. Sin efecto si no es mayor que priority. */
+#else
+#define TASK_CONFIG_THRESHOLD_FIELDS
+#endif /* OS_PREEMPTION_THRESHOLD */
+
+#ifdef OS_SUPERVISOR
+#define TASK_CONFIG_SUPERVISOR_FIELDS \
+    uint16_t watchdog_ticks;            /* Intervalo máximo entre reportes al supervisor. 0 si no está supervisada. */
+#else
+#define TASK_CONFIG_SUPERVISOR_FIELDS
+#endif /* OS_SUPERVISOR */
+
 typedef struct _task_t {
     task_state_e state;                 /* Estado actual de la tarea. */
-    task_function_t task_function;      /* Direccin de inicio de la tarea. */
-    uint8_t priority;                   /* Prioridad, en rango 0-255. */
-    uint8_t autostart;                  /* Si es TRUE, la inicializacin del sistema activa la tarea automticamente. */
-    uint16_t ticks_to_wait;             /* Nmero mximo de ticks que puede pasar la tarea en estado wait. */
-    uint16_t stack[TASK_STACK_SIZE];    /* Memoria para guardar el contexto de la tarea (R0-R15). */
+#ifndef OS_STATIC_CONFIG
+    TASK_CONFIG_FIELDS
+    TASK_CONFIG_EDF_FIELDS
+    TASK_CONFIG_THRESHOLD_FIELDS
+    TASK_CONFIG_SUPERVISOR_FIELDS
+#endif /* OS_STATIC_CONFIG */
+    uint8_t activations;                /* Activaciones registradas, incluyendo la activación en curso. */
+#ifdef OS_PREEMPTION_THRESHOLD
+    uint8_t preempted;                  /* Distinto de 0 si otra tarea desplazó a la tarea durante su ejecución. */
+#endif /* OS_PREEMPTION_THRESHOLD */
+    uint16_t ticks_to_wait;             /* Número máximo de ticks que puede pasar la tarea en estado wait. */
+#ifdef OS_QUEUES
+    uint8_t receive_min;                /* Elementos que espera la tarea como receptor de una queue. */
+#endif /* OS_QUEUES */
+#ifdef OS_ROUND_ROBIN
+    uint8_t rr_turn;                    /* Distinto de 0 si la tarea tiene el turno de round-robin de su prioridad. */
+    uint16_t rr_ticks;                  /* Ticks restantes del time slice del turno. */
+#endif /* OS_ROUND_ROBIN */
+#ifdef OS_SCHEDULER_EDF
+    uint16_t ticks_to_release;          /* Ticks restantes para el inicio del siguiente periodo. */
+    uint16_t ticks_to_deadline;         /* Ticks restantes para el deadline absoluto del periodo actual. */
+    uint8_t deadline_misses;            /* Número de deadlines perdidos, satura en 255. */
+#endif /* OS_SCHEDULER_EDF */
+#ifdef OS_SUPERVISOR
+    uint16_t checkin_ticks;             /* Ticks desde el último reporte al supervisor o la última terminación. */
+#endif /* OS_SUPERVISOR */
 } task_t;
 
+#ifdef OS_STATIC_CONFIG
+typedef struct _task_config_t {
+    TASK_CONFIG_FIELDS
+    TASK_CONFIG_EDF_FIELDS
+    TASK_CONFIG_THRESHOLD_FIELDS
+    TASK_CONFIG_SUPERVISOR_FIELDS
+} task_config_t;
+
+/* Alarma definida en app.oil. Las alarmas con autostart se inician en os_init. */
+typedef struct _alarm_config_t {
+    uint8_t task_to_activate;           /* Tarea que activa la alarma cuando expira. OS_TASK_ID_MAX si tiene callback. */
+    uint8_t autostart;                  /* Si es TRUE, os_init inicia la alarma. */
+    uint16_t alarm_time;                /* Ticks hasta la primera expiración, si la alarma tiene autostart. */
+    uint16_t cycle_time;                /* Ticks entre expiraciones. Es 0 si la alarma es de activación única. */
+#ifdef OS_TIMER_SERVICE
+    void (*callback)(void);             /* Función que ejecuta la tarea de servicio de timers, o 0 si activa una tarea. */
+#endif /* OS_TIMER_SERVICE */
+} alarm_config_t;
+
+#ifdef OS_QUEUES
+typedef struct _queue_config_t {
+    uint8_t length;                     /* Número de elementos que puede contener la queue. */
+    uint8_t tasks_with_access;          /* Campo de bits con las tareas que tienen acceso a la queue. */
+} queue_config_t;
+#endif /* OS_QUEUES */
+
+extern const task_config_t os_task_config[NUM_TASK_MAX];
+extern const alarm_config_t os_alarm_config[];
+#ifdef OS_QUEUES
+extern const queue_config_t os_queue_config[];
+#endif /* OS_QUEUES */
+
+#define TASK_CONFIG(task_id)        (os_task_config[(task_id)])
+#else
+#define TASK_CONFIG(task_id)        (tasks[(task_id)])
+#endif /* OS_STATIC_CONFIG */
+
+// Las tareas básicas y corrutinas no tienen contexto propio. El scheduler las despacha como llamadas anidadas.
+#define TASK_IS_STACKLESS(task_id)  (OS_TASK_CLASS_EXTENDED != TASK_CONFIG(task_id).task_class)
+
+/*
+ * Posición de cada registro en el contexto de una tarea extendida (palabras de task_contexts). R4-R10 ocupan las
+ * posiciones 0-6. port_context_switch (os/port.asm) usa los mismos offsets en bytes; deben cambiar juntos.
+ */
+#define TASK_CONTEXT_R4     (0u)
+#define TASK_CONTEXT_SR     (7u)
+#define TASK_CONTEXT_SP     (8u)
+#define TASK_CONTEXT_PC     (9u)
+
+/*
+ * Bytes del stack de una tarea extendida que usa el kernel mientras la tarea está desplazada por una ISR declarada con
+ * OS_ISR: el marco de RETI (4), R11-R15 (10), los retornos de scheduler_preempt y scheduler_run (4), los registros
+ * que guarda scheduler_run y sus variables locales, incluyendo el critical_state_t (hasta 22), y el SR y el retorno
+ * que apila port_context_switch (4). El resto de OS_TASK_STACK_BYTES queda para la tarea, las tareas básicas que se
+ * despachan sobre ella y el handler de la ISR.
+ */
+#define TASK_STACK_KERNEL_BYTES     (48u)
+
+// Contexto de una tarea extendida, y dirección inicial de su stack.
+#define TASK_CONTEXT(task_id)       (task_contexts[TASK_CONFIG(task_id).context_id])
+#define TASK_STACK_TOP(context_id)  ((uint16_t) (OS_TASK_STACK_TOP - ((uint16_t) (context_id) * OS_TASK_STACK_BYTES)))
+
 extern volatile task_t tasks[];
 
+/* Memoria para guardar el contexto (R0-R15) de cada tarea extendida. */
+extern volatile uint16_t task_contexts[OS_EXTENDED_TASK_COUNT][TASK_STACK_SIZE];
+
 extern volatile task_id_t current_task;
 extern volatile uint8_t num_active_tasks;
 
-extern volatile uint8_t scheduler_from_isr;
+/*
+ * Distinto de 0 si una ISR activó una tarea. El epílogo común de las ISRs (os_isr_exit, en os/port.asm) ejecuta el
+ * scheduler antes de regresar a la tarea interrumpida.
+ */
+extern volatile uint8_t os_switch_pending;
+
+/*
+ * Estado de las secciones críticas (os/critical.h) de la tarea actual. El scheduler lo guarda en el stack de la tarea
+ * cuando cambia de tarea o despacha una tarea básica, y cada tarea comienza sin secciones críticas.
+ */
+typedef struct _critical_state_t {
+    uint8_t nesting;                    /* Anidamiento de os_enter_critical. */
+    uint8_t interrupt_state;            /* Distinto de 0 si GIE estaba activado al entrar a la sección externa. */
+    uint8_t tick_nesting;               /* Anidamiento de os_enter_tick_critical. */
+    uint8_t tick_interrupt_state;       /* Distinto de 0 si la interrupción de systick estaba activada. */
+} critical_state_t;
+
+extern volatile critical_state_t os_critical;
 
-volatile uint16_t * current_task_stack;
+/* Ticks desde os_init (os_time_t). Solo systick_isr lo modifica; las tareas lo leen con os_time_get. */
+extern volatile uint32_t os_tick_count;
+
+/* Número de tareas básicas anidadas en ejecución. */
+extern volatile uint8_t basic_task_depth;
 
 void scheduler_run(void);
 
+/**
+ * @brief Ejecuta el scheduler desde os_isr_exit, con interrupciones desactivadas. La tarea interrumpida pasa a estado
+ * ready para que compita con las tareas que activó la ISR.
+ */
+void scheduler_preempt(void);
+
+/**
+ * @brief Procesa un tick: alarmas, esperas con timeout, tablas de activación y time slices. Llamada por systick_isr
+ * (os/port.asm).
+ */
+void systick_handler(void);
+
+/**
+ * @brief Guarda el estado de las secciones críticas de la tarea actual y lo reinicia para otra tarea. Si la tarea
+ * estaba en una sección crítica respecto a systick, vuelve a activar la interrupción de systick. Debe llamarse con
+ * interrupciones desactivadas.
+ *
+ * @return Estado que recibe critical_resume cuando la tarea continúa.
+ */
+critical_state_t critical_suspend(void);
+
+/**
+ * @brief Recupera el estado de las secciones críticas que guardó critical_suspend. Debe llamarse con interrupciones
+ * desactivadas.
+ */
+void critical_resume(critical_state_t critical);
+
+#ifdef OS_GPIO_IRQ
+/**
+ * @brief Handlers de las ISRs de PORT1 y PORT2 (os/port.asm). Llaman al handler de cada pin con interrupción pendiente.
+ */
+void gpio_port1_handler(void);
+void gpio_port2_handler(void);
+
+/**
+ * @brief Descuenta un tick del debounce de los pines. Si el nivel de un pin se mantuvo, llama a su handler y vuelve a
+ * activar su interrupción. Debe llamarse desde systick_isr.
+ */
+void gpio_irq_tick(void);
+#endif /* OS_GPIO_IRQ */
+
+#ifdef OS_LOW_POWER_IDLE
+/*
+ * Registra en next (tick_type_t) un evento del kernel que ocurre en ticks ticks. next en OS_MAX_TICKS significa que no
+ * hay eventos, entonces un evento a OS_MAX_TICKS ticks se registra un tick antes.
+ */
+#define OS_NEXT_EVENT(next, ticks) do {\
+    if (0u != (ticks) && (ticks) <= (next))\
+    {\
+        (next) = ((ticks) < OS_MAX_TICKS) ? (ticks) : (tick_type_t) (OS_MAX_TICKS - 1u);\
+    }\
+} while (0)
+
+/**
+ * @brief Funciones *_next_event: registran con OS_NEXT_EVENT el siguiente evento de cada servicio que procesa
+ * systick_isr. Llamadas por os_idle con interrupciones desactivadas.
+ */
+void alarms_next_event(tick_type_t * next);
+#ifdef OS_SCHEDULE_TABLES
+void schedtable_next_event(tick_type_t * next);
+#endif /* OS_SCHEDULE_TABLES */
+#ifdef OS_SCHEDULER_EDF
+void scheduler_edf_next_event(tick_type_t * next);
+#endif /* OS_SCHEDULER_EDF */
+#ifdef OS_GPIO_IRQ
+void gpio_irq_next_event(tick_type_t * next);
+#endif /* OS_GPIO_IRQ */
+#ifdef OS_SUPERVISOR
+void supervisor_next_event(tick_type_t * next);
+
+/**
+ * @brief Detiene el watchdog antes de que os_idle duerma en LPM3 o LPM4, y lo reinicia al despertar. Con una falla
+ * registrada, el watchdog sigue contando.
+ */
+void supervisor_suspend(void);
+void supervisor_resume(void);
+#endif /* OS_SUPERVISOR */
+
+#ifdef OS_IDLE_TICKLESS
+/* Distinto de 0 mientras os_idle duerme en LPM3 con el timer de systick en ACLK. */
+extern volatile uint8_t idle_tickless;
+
+/**
+ * @brief Configura ACLK con el VLO y mide su frecuencia con SMCLK. Llamada por os_init antes de iniciar systick.
+ */
+void idle_init(void);
+
+/**
+ * @brief Funciones *_skip: descuentan ticks ticks de los contadores de cada servicio sin procesar eventos. ticks es
+ * menor que el siguiente evento registrado con *_next_event. Llamadas por os_idle al despertar de LPM3.
+ */
+#ifdef OS_SCHEDULE_TABLES
+void schedtable_skip(tick_type_t ticks);
+#endif /* OS_SCHEDULE_TABLES */
+#ifdef OS_SCHEDULER_EDF
+void scheduler_edf_skip(tick_type_t ticks);
+#endif /* OS_SCHEDULER_EDF */
+#ifdef OS_GPIO_IRQ
+void gpio_irq_skip(tick_type_t ticks);
+#endif /* OS_GPIO_IRQ */
+#ifdef OS_SUPERVISOR
+void supervisor_skip(tick_type_t ticks);
+#endif /* OS_SUPERVISOR */
+#endif /* OS_IDLE_TICKLESS */
+#endif /* OS_LOW_POWER_IDLE */
+
+#ifdef OS_CRITICAL_PROFILER
+/**
+ * @brief Inicia una ventana del profiler, si no hay otra ventana del mismo tipo abierta; si la hay, la nueva ventana
+ * es parte de la ventana externa. Usar a través de PROFILER_START.
+ */
+void profiler_start(uint8_t kind, const char * file, uint16_t line);
+
+/**
+ * @brief Termina la ventana abierta del tipo kind y la registra en su punto del código.
+ */
+void profiler_stop(uint8_t kind);
+
+#define PROFILER_START(kind)    profiler_start((kind), __FILE__, __LINE__)
+#define PROFILER_STOP(kind)     profiler_stop(kind)
+#else
+#define PROFILER_START(kind)    ((void) 0)
+#define PROFILER_STOP(kind)     ((void) 0)
+#endif /* OS_CRITICAL_PROFILER */
+
+/**
+ * @brief Guarda el contexto de la tarea actual y carga el contexto de otra tarea. Implementada en os/port.asm.
+ *
+ * Solo guarda los registros que una llamada a función debe preservar; el compilador ya guardó los demás antes de la
+ * llamada. La tarea guardada continúa como si la función hubiera retornado, con el mismo valor de GIE.
+ *
+ * @param save_context Contexto donde guardar la tarea actual, o 0 si la tarea actual no debe guardarse.
+ * @param restore_context Contexto de la tarea que continúa.
+ */
+void port_context_switch(volatile uint16_t * save_context, volatile uint16_t * restore_context);
+
+/**
+ * @brief Activa una tarea sin ejecutar el scheduler. Usada por los servicios que activan tareas desde
+ * systick_isr (alarmas, tablas de activación).
+ *
+ * Si la tarea está suspendida, pasa a estado ready. Si ya está activa, registra la activación para que la tarea
+ * vuelva a ejecutarse cuando termine.
+ *
+ * @return OS_OK si activó la tarea o registró la activación.
+ *         OS_ERROR_INVALID_ARGUMENT si task_id no es un identificador válido o la tarea no fue creada.
+ *         OS_ERROR_MAX_ACTIVATIONS si la tarea ya tiene OS_TASK_ACTIVATIONS_MAX activaciones registradas.
+ */
+error_id_e task_activate(task_id_t task_id);
+
+/**
+ * @brief Registra los atributos de una tarea de cualquier clase. Si es una tarea extendida, le asigna un contexto.
+ *
+ * @return OS_OK si registró la tarea.
+ *         OS_ERROR_INVALID_ARGUMENT si task_id no es un identificador válido.
+ *         OS_ERROR_MAX_CREATED_TASKS si ya no hay contextos libres para una tarea extendida.
+ */
+#ifndef OS_STATIC_CONFIG
+error_id_e task_create(task_id_t task_id, task_function_t task_function, uint8_t priority, uint8_t autostart,
+                       task_class_e task_class);
+#endif /* OS_STATIC_CONFIG */
+
+#ifdef OS_TIMER_SERVICE
+/**
+ * @brief Activa la tarea de servicio de timers (OS_TIMER_SERVICE_TASK_ID), si no tiene ya una activación registrada
+ * además de la que está en curso. No ejecuta el scheduler.
+ *
+ * @return 1 si activó la tarea, 0 si no fue necesario.
+ */
+uint8_t timer_service_activate(void);
+#endif /* OS_TIMER_SERVICE */
+
+#ifdef OS_DEFERRED_CALLS
+/**
+ * @brief Ejecuta las llamadas diferidas registradas con os_defer_from_isr. Llamada por os_timer_service_task.
+ */
+void deferred_calls_run(void);
+#endif /* OS_DEFERRED_CALLS */
+
+#ifdef OS_STATIC_CONFIG
+/**
+ * @brief Inicializa el estado de las tareas de os_task_config: todas quedan suspendidas, y cada tarea extendida recibe
+ * su contexto inicial. Llamada por os_init.
+ */
+void tasks_init(void);
+
+/**
+ * @brief Inicia las alarmas de os_alarm_config que tienen autostart. Llamada por os_init.
+ */
+void alarms_init(void);
+#endif /* OS_STATIC_CONFIG */
+
+/**
+ * @brief Termina la activación en curso de una tarea. Si la tarea tiene activaciones registradas, queda en estado
+ * ready para ejecutarse otra vez; si no, queda suspendida. No ejecuta el scheduler.
+ */
+void task_end(task_id_t task_id);
+
+/**
+ * @brief Revisa si la tarea actual puede pasar a estado wait. Solo las tareas extendidas tienen contexto propio; las
+ * tareas básicas y corrutinas no pueden esperar, y antes de os_init no hay tarea actual.
+ *
+ * @return 1 si la tarea actual puede esperar, 0 si no.
+ */
+uint8_t task_can_wait(void);
+
+#ifdef OS_ROUND_ROBIN
+/**
+ * @brief Descuenta un tick del time slice de la tarea actual, si tiene el turno de round-robin de su prioridad. Debe
+ * llamarse desde systick_isr.
+ *
+ * @return 1 si expiró el time slice y hay otra tarea lista con la misma prioridad (hace falta ejecutar el scheduler).
+ *         0 en otro caso.
+ */
+uint8_t scheduler_rr_tick(void);
+#endif /* OS_ROUND_ROBIN */
+
+#ifdef OS_SCHEDULE_TABLES
+/**
+ * @brief Descuenta un tick del contador de cada tabla de activación en ejecución y procesa los puntos de expiración
+ * que alcanzaron su offset. Debe llamarse desde systick_isr.
+ *
+ * @return 1 si activó al menos una tarea (hace falta ejecutar el scheduler).
+ *         0 en otro caso.
+ */
+uint8_t schedtable_tick(void);
+#endif /* OS_SCHEDULE_TABLES */
+
+#ifdef OS_SCHEDULER_EDF
+/**
+ * @brief Descuenta un tick de los periodos y deadlines de las tareas periódicas. Debe llamarse desde systick_isr.
+ *
+ * Inicia un nuevo periodo para cada tarea cuyo periodo terminó, y registra los deadlines perdidos.
+ *
+ * @return 1 si activó al menos una tarea (hace falta ejecutar el scheduler).
+ *         0 en otro caso.
+ */
+uint8_t scheduler_edf_tick(void);
+#endif /* OS_SCHEDULER_EDF */
+
+#ifdef OS_SUPERVISOR
+/**
+ * @brief Inicia el watchdog y, si el watchdog reinició el MSP430 sin un registro de falla, lo registra. Llamada por
+ * os_init.
+ */
+void supervisor_init(void);
+
+/**
+ * @brief Cuenta un tick del intervalo de cada tarea supervisada activa, registra la primera tarea que excede su
+ * intervalo y reinicia el watchdog si ninguna lo excedió. Debe llamarse desde systick_isr.
+ */
+void supervisor_tick(void);
+#endif /* OS_SUPERVISOR */
+
+#ifdef OS_DVFS
+/**
+ * @brief Marca el inicio del tiempo que el CPU duerme. Llamada por os_idle antes de dormir.
+ */
+void dvfs_idle_enter(void);
+
+/**
+ * @brief Suma el tiempo que el CPU durmió a la ventana actual del governor. Llamada por os_idle al despertar y por
+ * scheduler_preempt, porque una ISR puede cambiar de tarea sin que os_idle continúe. No hace nada si el CPU no dormía.
+ */
+void dvfs_idle_exit(void);
+
+/**
+ * @brief Cuenta un tick de la ventana del governor y, al terminar la ventana, cambia la frecuencia del DCO según la
+ * carga. Debe llamarse desde systick_isr, después de avanzar SYSTICK_CCR.
+ */
+void dvfs_tick(void);
+#endif /* OS_DVFS */
+
 #endif /* OS_PRIVATEINCLUDE_OS_PRIVATE_H_ */
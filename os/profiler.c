@@ -0,0 +1,242 @@
+/*
+ * profiler.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include <msp430.h>
+
+#include "profiler.h"
+#include "systime.h"
+
+#include "os_private.h"
+
+#include "em.h"
+#include "hal_uart.h"
+
+#ifdef OS_CRITICAL_PROFILER
+
+typedef struct _profiler_window_t {
+    const char * file;
+    uint16_t line;
+    uint16_t start;                     /* Valor del contador de systick al iniciar la ventana. */
+    uint8_t open;
+} profiler_window_t;
+
+static volatile profiler_window_t profiler_windows[OS_PROFILER_KIND_MAX];
+static volatile os_profiler_site_t profiler_sites[OS_PROFILER_SITES];
+static volatile uint16_t profiler_dropped;
+
+static void profiler_record(uint8_t kind, const char * file, uint16_t line, uint16_t counts);
+static void profiler_send(const uint8_t * buf, uint8_t len);
+static void profiler_send_str(const char * str);
+static void profiler_send_num(uint32_t value);
+
+void profiler_start(uint8_t kind, const char * file, uint16_t line)
+{
+    if (profiler_windows[kind].open)
+    {
+        // Ventana anidada, es parte de la ventana externa.
+        return;
+    }
+
+    profiler_windows[kind].file = file;
+    profiler_windows[kind].line = line;
+    profiler_windows[kind].open = 1u;
+    profiler_windows[kind].start = SYSTICK_TAR;
+}
+
+void profiler_stop(uint8_t kind)
+{
+    uint16_t counts = SYSTICK_TAR - profiler_windows[kind].start;
+#ifdef OS_DVFS
+    uint32_t scaled;
+#endif /* OS_DVFS */
+
+    if (profiler_windows[kind].open)
+    {
+        profiler_windows[kind].open = 0u;
+#ifdef OS_DVFS
+        // Las cuentas del timer dependen de la frecuencia del DCO; el profiler las guarda como timestamps.
+        scaled = SYSTICK_COUNTS_TO_TIMESTAMP(counts);
+        counts = (0xFFFFu < scaled) ? 0xFFFFu : (uint16_t) scaled;
+#endif /* OS_DVFS */
+        profiler_record(kind, profiler_windows[kind].file, profiler_windows[kind].line, counts);
+    }
+}
+
+static void profiler_record(uint8_t kind, const char * file, uint16_t line, uint16_t counts)
+{
+    uint8_t i;
+    uint8_t bucket;
+
+    for (i = 0u; i < OS_PROFILER_SITES; i++)
+    {
+        if (0 == profiler_sites[i].file)
+        {
+            profiler_sites[i].file = file;
+            profiler_sites[i].line = line;
+            profiler_sites[i].kind = kind;
+            break;
+        }
+
+        if (file == profiler_sites[i].file && line == profiler_sites[i].line && kind == profiler_sites[i].kind)
+        {
+            break;
+        }
+    }
+
+    if (OS_PROFILER_SITES <= i)
+    {
+        if (0xFFFFu != profiler_dropped)
+        {
+            profiler_dropped++;
+        }
+        return;
+    }
+
+    if (counts > profiler_sites[i].max_counts)
+    {
+        profiler_sites[i].max_counts = counts;
+    }
+
+    bucket = 0u;
+    while ((OS_PROFILER_BUCKETS - 1u) > bucket &&
+           OS_US_TO_TIMESTAMP((uint32_t) OS_PROFILER_BUCKET_US << bucket) <= counts)
+    {
+        bucket++;
+    }
+
+    if (0xFFFFu != profiler_sites[i].histogram[bucket])
+    {
+        profiler_sites[i].histogram[bucket]++;
+    }
+}
+
+error_id_e os_profiler_get(uint8_t index, os_profiler_site_t * out_site)
+{
+    uint16_t interrupt_state;
+
+    if (OS_PROFILER_SITES <= index || 0 == out_site || 0 == profiler_sites[index].file)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Copiar con interrupciones desactivadas. No usa os_enter_critical para no registrar la copia.
+    interrupt_state = __get_SR_register() & GIE;
+    EM_GLOBAL_INTERRUPT_DIS;
+
+    *out_site = profiler_sites[index];
+
+    if (interrupt_state)
+    {
+        EM_GLOBAL_INTERRUPT_EN;
+    }
+
+    return OS_OK;
+}
+
+uint16_t os_profiler_dropped(void)
+{
+    return profiler_dropped;
+}
+
+void os_profiler_reset(void)
+{
+    uint16_t interrupt_state = __get_SR_register() & GIE;
+    uint8_t i;
+
+    EM_GLOBAL_INTERRUPT_DIS;
+
+    for (i = 0u; i < OS_PROFILER_SITES; i++)
+    {
+        profiler_sites[i] = (os_profiler_site_t) { 0 };
+    }
+    profiler_dropped = 0u;
+
+    if (interrupt_state)
+    {
+        EM_GLOBAL_INTERRUPT_EN;
+    }
+}
+
+void os_profiler_dump(void)
+{
+    static const char * const kind_names[OS_PROFILER_KIND_MAX] = { " irq max=", " tick max=" };
+    os_profiler_site_t site;
+    const char * name;
+    uint8_t i;
+    uint8_t j;
+
+    for (i = 0u; OS_OK == os_profiler_get(i, &site); i++)
+    {
+        // Solo el nombre del archivo, sin la ruta.
+        name = site.file;
+        for (j = 0u; '\0' != site.file[j]; j++)
+        {
+            if ('/' == site.file[j] || '\\' == site.file[j])
+            {
+                name = &site.file[j + 1u];
+            }
+        }
+
+        profiler_send_str(name);
+        profiler_send_str(":");
+        profiler_send_num(site.line);
+        profiler_send_str(kind_names[site.kind]);
+        profiler_send_num(OS_TIMESTAMP_TO_US(site.max_counts));
+        profiler_send_str("us");
+
+        for (j = 0u; j < OS_PROFILER_BUCKETS; j++)
+        {
+            profiler_send_str((0u == j) ? " " : ",");
+            profiler_send_num(site.histogram[j]);
+        }
+
+        profiler_send_str("\r\n");
+    }
+}
+
+/*
+ * hal_uart_send copia solo lo que cabe en su buffer. Esperar a que la ISR de la UART libere espacio.
+ */
+static void profiler_send(const uint8_t * buf, uint8_t len)
+{
+    uint8_t sent = 0u;
+
+    while (sent < len)
+    {
+        sent += hal_uart_send(&buf[sent], len - sent);
+    }
+}
+
+static void profiler_send_str(const char * str)
+{
+    uint8_t len = 0u;
+
+    while ('\0' != str[len] && (UART_SEND_MAX_LEN - 1u) > len)
+    {
+        len++;
+    }
+
+    profiler_send((const uint8_t *) str, len);
+}
+
+/*
+ * Envía value en decimal.
+ */
+static void profiler_send_num(uint32_t value)
+{
+    uint8_t digits[10];
+    uint8_t i = sizeof(digits);
+
+    do
+    {
+        digits[--i] = (uint8_t) ('0' + (value % 10u));
+        value /= 10u;
+    } while (0u != value);
+
+    profiler_send(&digits[i], sizeof(digits) - i);
+}
+
+#endif /* OS_CRITICAL_PROFILER */
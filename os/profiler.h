@@ -0,0 +1,78 @@
+/*
+ * profiler.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+
+#ifndef OS_PROFILER_H_
+#define OS_PROFILER_H_
+
+#include <stdint.h>
+
+#include "os.h"
+#include "os_config.h"
+
+/*
+ * Profiler de secciones críticas. Cada ventana se mide desde que se desactivan las interrupciones (o la interrupción de
+ * systick) hasta que se vuelven a activar, y se registra en el punto del código que la inició: la llamada externa a
+ * os_enter_critical u os_enter_tick_critical, el scheduler o systick_isr. Las ventanas anidadas son parte de la ventana
+ * externa.
+ *
+ * Si una tarea espera dentro de una sección crítica, la ventana termina cuando el scheduler cambia de tarea; el resto
+ * de la sección, después de que la tarea continúa, no se mide. Las ventanas deben durar menos de 65535 cuentas del
+ * timer de systick (8 ms a 8 MHz).
+ */
+
+#define OS_PROFILER_BUCKETS         (4u)
+
+typedef enum _os_profiler_kind_e {
+    OS_PROFILER_KIND_IRQ,               /* Todas las interrupciones desactivadas. */
+    OS_PROFILER_KIND_TICK,              /* Solo la interrupción de systick desactivada. */
+    OS_PROFILER_KIND_MAX,
+} os_profiler_kind_e;
+
+typedef struct _os_profiler_site_t {
+    const char * file;                  /* Archivo del punto del código (__FILE__), o 0 si la entrada está libre. */
+    uint16_t line;                      /* Línea del punto del código. */
+    uint8_t kind;                       /* Uno de OS_PROFILER_KIND_*. */
+    uint16_t max_counts;                /* Duración máxima, en cuentas del timer de systick (OS_TIMESTAMP_TO_US). */
+    uint16_t histogram[OS_PROFILER_BUCKETS];   /* Ventanas por intervalo de duración; satura en 65535. */
+} os_profiler_site_t;
+
+#ifdef OS_CRITICAL_PROFILER
+
+/**
+ * @brief Copia las estadísticas de un punto del código.
+ *
+ * @param index Índice del punto, menor a OS_PROFILER_SITES. Los puntos se registran en el orden en que aparecen.
+ * @param out_site Espacio para recibir las estadísticas.
+ *
+ * @return OS_OK si copió las estadísticas.
+ *         OS_ERROR_INVALID_ARGUMENT si index no tiene un punto registrado o out_site es nulo.
+ */
+error_id_e os_profiler_get(uint8_t index, os_profiler_site_t * out_site);
+
+/**
+ * @brief Número de ventanas que no se registraron porque la tabla de puntos estaba llena.
+ */
+uint16_t os_profiler_dropped(void);
+
+/**
+ * @brief Borra todos los puntos registrados.
+ */
+void os_profiler_reset(void);
+
+/**
+ * @brief Envía las estadísticas por UART, una línea por punto:
+ *
+ * "queues.c:64 irq max=37us 12,3,0,0"
+ *
+ * Los valores después de max son el histograma (menos de OS_PROFILER_BUCKET_US, menos del doble, etc.). Debe llamarse
+ * desde una tarea con interrupciones activadas, porque espera a que la UART tenga espacio.
+ */
+void os_profiler_dump(void);
+
+#endif /* OS_CRITICAL_PROFILER */
+
+#endif /* OS_PROFILER_H_ */
@@ -5,24 +5,65 @@
  *      Author: Fernando Mendoza V.
  */
 #include "queues.h"
+#include "critical.h"
+#include "systime.h"
 
 #include "os_private.h"
 
-#include "em.h"
+#ifdef OS_COROUTINES
+#include "coroutines.h"
+#endif /* OS_COROUTINES */
 
-// Workaround temporal. Queues usan n-1 espacios, desperdiciando el ltimo. Modificar algoritmo de queues para aprovecharlo.
+/* Elemento de una queue: un puntero, o un valor del tamaño de un puntero (16 bits en el MSP430). */
+typedef uintptr_t queue_item_t;
+
+// Workaround temporal. Queues usan n-1 espacios, desperdiciando el último. Modificar algoritmo de queues para aprovecharlo.
 //TODO: Modificar send y receive para que usen todos los elementos de queue_t.data, en vez de length - 1.
 typedef struct _queue_t {
-    uint16_t data[OS_QUEUE_LEN_MAX + 1u];   /* Arreglo de punteros a los datos. */
+    queue_item_t data[OS_QUEUE_LEN_MAX + 1u];   /* Arreglo de punteros a los datos. */
     uint16_t tasks_waiting;                 /* MSB son tareas esperando espacio libre, LSB son tareas esperando al menos un elemento. */
-    uint8_t length;                         /* Nmero de elementos que puede contener la queue. */
+#ifndef OS_STATIC_CONFIG
+    uint8_t length;                         /* Número de elementos que puede contener la queue. */
     uint8_t tasks_with_access;              /* Campo de bits donde un bit set indica que la tarea con el ID correspondiente tiene acceso a la queue. */
-    uint8_t head;                           /* ndice del primer elemento de la queue. */
-    uint8_t tail;                           /* ndice del elemento final de la queue. */
+#endif /* OS_STATIC_CONFIG */
+    uint8_t head;                           /* Índice del primer elemento de la queue. */
+    uint8_t tail;                           /* Índice del elemento final de la queue. */
+#ifdef OS_QUEUE_ZERO_COPY
+    uint8_t * storage;                      /* Almacenamiento de los espacios (os_queue_set_storage), o 0. */
+    uint8_t item_size;                      /* Bytes de cada espacio en storage. */
+    uint8_t slot_state;                     /* QUEUE_SLOT_RESERVED y QUEUE_SLOT_ACQUIRED. */
+#endif /* OS_QUEUE_ZERO_COPY */
 } queue_t;
 
+// Con OS_STATIC_CONFIG, la longitud y los permisos de cada queue están en os_queue_config (flash).
+#ifdef OS_STATIC_CONFIG
+#define QUEUE_LENGTH(id)    ((uint8_t) (os_queue_config[(id)].length + 1u))     /*TODO: Eliminar + 1*/
+#define QUEUE_ACCESS(id)    (os_queue_config[(id)].tasks_with_access)
+#else
+#define QUEUE_LENGTH(id)    (queues[(id)].length)
+#define QUEUE_ACCESS(id)    (queues[(id)].tasks_with_access)
+#endif /* OS_STATIC_CONFIG */
+
+// Bits de una tarea en queue_t.tasks_waiting.
+#define QUEUE_RECEIVER(task)    ((uint16_t) (0xFFu & (1u << (task))))
+#define QUEUE_SENDER(task)      ((uint16_t) (QUEUE_RECEIVER(task) << 8u))
+
+// Con una reserva, la queue está llena para los demás emisores; con un elemento tomado, está vacía para los demás
+// receptores (ver os_queue_reserve y os_queue_peek_acquire).
+#ifdef OS_QUEUE_ZERO_COPY
+#define QUEUE_SLOT_RESERVED     (0x01u)
+#define QUEUE_SLOT_ACQUIRED     (0x02u)
+
+#define QUEUE_RESERVED(id)      (QUEUE_SLOT_RESERVED & queues[(id)].slot_state)
+#define QUEUE_ACQUIRED(id)      (QUEUE_SLOT_ACQUIRED & queues[(id)].slot_state)
+#else
+#define QUEUE_RESERVED(id)      (0u)
+#define QUEUE_ACQUIRED(id)      (0u)
+#endif /* OS_QUEUE_ZERO_COPY */
+
 static queue_t queues[OS_QUEUE_COUNT_MAX];
 
+#ifndef OS_STATIC_CONFIG
 error_id_e os_queue_init(queue_id_t id, uint8_t length, uint8_t access)
 {
     if (OS_QUEUE_COUNT_MAX <= id || 0u == length || 0u == access)
@@ -39,15 +80,103 @@ error_id_e os_queue_init(queue_id_t id, uint8_t length, uint8_t access)
 
     return OS_OK;
 }
+#endif /* OS_STATIC_CONFIG */
+
+/*
+ * Número de elementos que pueden recibir los receptores.
+ */
+static uint8_t queue_count(queue_id_t id)
+{
+    if (QUEUE_ACQUIRED(id))
+    {
+        return 0u;
+    }
+
+    if (queues[id].tail >= queues[id].head)
+    {
+        return queues[id].tail - queues[id].head;
+    }
+
+    return QUEUE_LENGTH(id) - queues[id].head + queues[id].tail;
+}
+
+/*
+ * Pasa a estado ready las tareas que esperaban a que la queue tuviera elementos, si la queue ya tiene los elementos
+ * que pide cada una (task_t.receive_min). Regresa 1 si despertó alguna tarea.
+ */
+static uint8_t queue_wake_receivers(queue_id_t id)
+{
+    uint8_t woken = 0u;
+    uint8_t count = queue_count(id);
+    uint8_t i;
+
+    i = NUM_TASK_MAX;
+    while (i--)
+    {
+        if (0u != (queues[id].tasks_waiting & ((uint16_t) (0xFFu & (1u << i)))) && count >= tasks[i].receive_min)
+        {
+            // La tarea i estaba esperando a que la queue no estuviera vacía. Pasarla a estado ready.
+            tasks[(task_id_t) i].state = OS_TASK_STATE_READY;
+            tasks[(task_id_t) i].ticks_to_wait = 0u;
+            woken = 1u;
+        }
+    }
+
+    return woken;
+}
+
+/*
+ * Pasa a estado ready las tareas que esperaban a que la queue tuviera espacio libre.
+ */
+static void queue_wake_senders(queue_id_t id)
+{
+    uint8_t i;
+
+    i = NUM_TASK_MAX;
+    while (i--)
+    {
+        if (0u != (queues[id].tasks_waiting & QUEUE_SENDER(i)))
+        {
+            tasks[(task_id_t) i].state = OS_TASK_STATE_READY;
+            tasks[(task_id_t) i].ticks_to_wait = 0u;
+        }
+    }
+}
+
+/*
+ * Espera en la queue hasta ticks ticks, con wait_mask (QUEUE_RECEIVER o QUEUE_SENDER de la tarea actual) en
+ * tasks_waiting. Se llama dentro de una sección crítica; la tarea continúa aquí cuando otra tarea o una ISR la
+ * despierta, o cuando expira el timeout.
+ */
+static void queue_wait(queue_id_t id, uint16_t wait_mask, tick_type_t ticks)
+{
+    queues[id].tasks_waiting |= wait_mask;
+    tasks[current_task].state = OS_TASK_STATE_WAIT;
+    tasks[current_task].ticks_to_wait = ticks;
+
+    scheduler_run();
+
+    queues[id].tasks_waiting &= ~wait_mask;
+}
+
+/*
+ * Ticks que faltan para expiry, o 0 si ya expiró.
+ */
+static tick_type_t queue_ticks_left(os_time_t expiry)
+{
+    int32_t ticks = (int32_t) (expiry - os_time_get());
+
+    return (0 < ticks) ? (tick_type_t) ticks : 0u;
+}
 
 error_id_e os_queue_send(queue_id_t id, const void * item, tick_type_t ticks_to_wait)
 {
     volatile register error_id_e status = OS_OK;
     volatile register uint8_t i;
 
-    EM_GLOBAL_INTERRUPT_DIS;
+    os_enter_critical();
 
-    if (OS_QUEUE_COUNT_MAX <= id || 0u == (queues[id].tasks_with_access & (1u << current_task)))
+    if (OS_QUEUE_COUNT_MAX <= id || 0u == (QUEUE_ACCESS(id) & (1u << current_task)))
     {
         status = OS_ERROR_INVALID_ARGUMENT;
     }
@@ -55,20 +184,24 @@ error_id_e os_queue_send(queue_id_t id, const void * item, tick_type_t ticks_to_
     if (OS_OK == status)
     {
         i = queues[id].tail + 1;
-        if (queues[id].length <= i)
+        if (QUEUE_LENGTH(id) <= i)
         {
             i = 0u;
         }
 
-        if (i != queues[id].head)
+        if (i != queues[id].head && !QUEUE_RESERVED(id))
         {
             // Queue tiene espacio libre, agregar elemento al final.
-            queues[id].data[queues[id].tail] = (uint16_t) item;
+            queues[id].data[queues[id].tail] = (queue_item_t) item;
             queues[id].tail = i;
         }
+        else if (0u != ticks_to_wait && !task_can_wait())
+        {
+            status = OS_ERROR_TASK_CLASS;
+        }
         else if (0u != ticks_to_wait)
         {
-            // Queue est llena. Tarea debe esperar al timeout o a que liberen espacio de la queue.
+            // Queue está llena. Tarea debe esperar al timeout o a que liberen espacio de la queue.
             queues[id].tasks_waiting |= ((uint16_t) (0xFFu & (1u << current_task))) << 8u;
             tasks[current_task].state = OS_TASK_STATE_WAIT;
             tasks[current_task].ticks_to_wait = ticks_to_wait;
@@ -77,18 +210,18 @@ error_id_e os_queue_send(queue_id_t id, const void * item, tick_type_t ticks_to_
 
             status = OS_OK;
             i = queues[id].tail + 1;
-            if (queues[id].length <= i)
+            if (QUEUE_LENGTH(id) <= i)
             {
                 i = 0u;
             }
 
-            // Tarea pas a estado wait por al menos un tick. Llega a este punto si expir el timeout o se liber espacio.
+            // Tarea pasó a estado wait por al menos un tick. Llega a este punto si expiró el timeout o se liberó espacio.
             queues[id].tasks_waiting &= ~(((uint16_t) (0xFFu & (1u << current_task))) << 8u);
 
-            if (i != queues[id].head)
+            if (i != queues[id].head && !QUEUE_RESERVED(id))
             {
-                // Se liber espacio en la queue mientras la tarea esperaba.
-                queues[id].data[queues[id].tail] = (uint16_t) item;
+                // Se liberó espacio en la queue mientras la tarea esperaba.
+                queues[id].data[queues[id].tail] = (queue_item_t) item;
                 queues[id].tail = i;
             }
             else
@@ -102,57 +235,84 @@ error_id_e os_queue_send(queue_id_t id, const void * item, tick_type_t ticks_to_
         }
     }
 
-    // Revisar si el nuevo elemento agregado desbloquea alguna tarea (queue ya no est vaca).
+    // Revisar si el nuevo elemento agregado desbloquea alguna tarea (queue ya no está vacía).
     if (OS_OK == status)
     {
-        i = NUM_TASK_MAX;
-        while (i--)
-        {
-            if (0u != (queues[id].tasks_waiting & ((uint16_t) (0xFFu & (1u << i)))))
-            {
-                // La tarea i estaba esperando a que la queue no estuviera vaca. Pasarla a estado ready.
-                tasks[(task_id_t) i].state = OS_TASK_STATE_READY;
-                tasks[(task_id_t) i].ticks_to_wait = 0u;
-            }
-        }
+        queue_wake_receivers(id);
     }
 
-    EM_GLOBAL_INTERRUPT_EN;
+    os_exit_critical();
 
     return status;
 }
 
+error_id_e os_queue_send_from_isr(queue_id_t id, const void * item)
+{
+    uint8_t i;
+
+    if (OS_QUEUE_COUNT_MAX <= id)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    i = queues[id].tail + 1;
+    if (QUEUE_LENGTH(id) <= i)
+    {
+        i = 0u;
+    }
+
+    if (i == queues[id].head || QUEUE_RESERVED(id))
+    {
+        return OS_ERROR_QUEUE_FULL;
+    }
+
+    queues[id].data[queues[id].tail] = (queue_item_t) item;
+    queues[id].tail = i;
+
+    if (queue_wake_receivers(id))
+    {
+        os_switch_pending = 1u;
+    }
+
+    return OS_OK;
+}
+
 error_id_e os_queue_receive(queue_id_t id, void * out_item, tick_type_t ticks_to_wait)
 {
     volatile register error_id_e status = OS_OK;
     volatile register uint8_t i;
 
-    EM_GLOBAL_INTERRUPT_DIS;
+    os_enter_critical();
 
-    if (OS_QUEUE_COUNT_MAX <= id || 0u == (queues[id].tasks_with_access & (1u << current_task)))
+    if (OS_QUEUE_COUNT_MAX <= id || 0u == (QUEUE_ACCESS(id) & (1u << current_task)))
     {
         status = OS_ERROR_INVALID_ARGUMENT;
     }
 
     if (OS_OK == status)
     {
-        if (queues[id].head != queues[id].tail)
+        if (queues[id].head != queues[id].tail && !QUEUE_ACQUIRED(id))
         {
             // Queue tiene al menos un elemento. Remover el elemento de la queue.
             i = queues[id].head;
-            *((uint16_t *) out_item) = queues[id].data[i];
+            *((queue_item_t *) out_item) = queues[id].data[i];
 
             i++;
-            if (queues[id].length <= i)
+            if (QUEUE_LENGTH(id) <= i)
             {
                 i = 0u;
             }
             queues[id].head = i;
         }
+        else if (0u != ticks_to_wait && !task_can_wait())
+        {
+            status = OS_ERROR_TASK_CLASS;
+        }
         else if (0u != ticks_to_wait)
         {
-            // Queue est vaca y timeout no es 0. Esperar a que queue tenga un elemento o al timeout.
+            // Queue está vacía y timeout no es 0. Esperar a que queue tenga un elemento o al timeout.
             queues[id].tasks_waiting |= ((uint16_t) (0xFFu & (1u << current_task)));
+            tasks[current_task].receive_min = 1u;
             tasks[current_task].state = OS_TASK_STATE_WAIT;
             tasks[current_task].ticks_to_wait = ticks_to_wait;
 
@@ -161,17 +321,17 @@ error_id_e os_queue_receive(queue_id_t id, void * out_item, tick_type_t ticks_to
             status = OS_OK;
             i = queues[id].head;
 
-            // Tarea pas a estado wait por al menos un tick. Llega a este punto si expir el timeout o queue recibi un elemento.
+            // Tarea pasó a estado wait por al menos un tick. Llega a este punto si expiró el timeout o queue recibió un elemento.
             queues[id].tasks_waiting &= ~((uint16_t) (0xFFu & (1u << current_task)));
 
-            if (queues[id].head != queues[id].tail)
+            if (queues[id].head != queues[id].tail && !QUEUE_ACQUIRED(id))
             {
-                // La queue recibi un elemento mientras la tarea esperaba.
+                // La queue recibió un elemento mientras la tarea esperaba.
                 i = queues[id].head;
-                *((uint16_t *) out_item) = queues[id].data[i];
+                *((queue_item_t *) out_item) = queues[id].data[i];
 
                 i++;
-                if (queues[id].length <= i)
+                if (QUEUE_LENGTH(id) <= i)
                 {
                     i = 0u;
                 }
@@ -188,23 +348,440 @@ error_id_e os_queue_receive(queue_id_t id, void * out_item, tick_type_t ticks_to
         }
     }
 
-    // Revisar si remover el elemento desbloquea alguna tarea (queue ya no est llena).
+    // Revisar si remover el elemento desbloquea alguna tarea (queue ya no está llena).
     if (OS_OK == status)
     {
-        i = NUM_TASK_MAX;
-        while (i--)
+        queue_wake_senders(id);
+    }
+
+    os_exit_critical();
+
+    return status;
+}
+
+error_id_e os_queue_send_many(queue_id_t id, const void * items, uint8_t count, uint8_t * sent,
+                              tick_type_t ticks_to_wait)
+{
+    error_id_e status = OS_OK;
+    os_time_t expiry = os_time_get() + ticks_to_wait;
+    tick_type_t ticks;
+    uint8_t num_sent = 0u;
+    uint8_t added = 0u;
+    uint8_t i;
+
+    os_enter_critical();
+
+    if (OS_QUEUE_COUNT_MAX <= id || 0u == (QUEUE_ACCESS(id) & (1u << current_task)) || 0 == items || 0u == count)
+    {
+        status = OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    while (OS_OK == status)
+    {
+        // Agregar todos los elementos que caben en la queue.
+        while (num_sent < count)
+        {
+            i = queues[id].tail + 1u;
+            if (QUEUE_LENGTH(id) <= i)
+            {
+                i = 0u;
+            }
+
+            if (i == queues[id].head || QUEUE_RESERVED(id))
+            {
+                break;
+            }
+
+            queues[id].data[queues[id].tail] = ((const queue_item_t *) items)[num_sent];
+            queues[id].tail = i;
+            num_sent++;
+            added = 1u;
+        }
+
+        if (count == num_sent)
+        {
+            break;
+        }
+
+        // Queue está llena. Los receptores deben recibir los elementos agregados antes de que la tarea espere espacio.
+        if (added)
+        {
+            added = 0u;
+            queue_wake_receivers(id);
+        }
+
+        ticks = (0u != ticks_to_wait) ? queue_ticks_left(expiry) : 0u;
+
+        if (0u == ticks)
+        {
+            status = OS_ERROR_QUEUE_FULL;
+        }
+        else if (!task_can_wait())
+        {
+            status = OS_ERROR_TASK_CLASS;
+        }
+        else
+        {
+            queue_wait(id, QUEUE_SENDER(current_task), ticks);
+        }
+    }
+
+    // Despertar a los receptores una vez por todo el lote.
+    if (added)
+    {
+        queue_wake_receivers(id);
+    }
+
+    os_exit_critical();
+
+    if (0 != sent)
+    {
+        *sent = num_sent;
+    }
+
+    return status;
+}
+
+error_id_e os_queue_receive_many(queue_id_t id, void * out_items, uint8_t max_count, uint8_t min_count,
+                                 uint8_t * received, tick_type_t ticks_to_wait)
+{
+    error_id_e status = OS_OK;
+    os_time_t expiry = os_time_get() + ticks_to_wait;
+    tick_type_t ticks;
+    uint8_t num_received = 0u;
+    uint8_t i;
+
+    os_enter_critical();
+
+    if (OS_QUEUE_COUNT_MAX <= id || 0u == (QUEUE_ACCESS(id) & (1u << current_task)) || 0 == out_items ||
+        0u == min_count || max_count < min_count || QUEUE_LENGTH(id) <= min_count)
+    {
+        status = OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Esperar a que la queue tenga min_count elementos. Otro receptor puede tomar los elementos antes de que la tarea
+    // continúe, entonces se revisa otra vez después de cada espera.
+    while (OS_OK == status && queue_count(id) < min_count)
+    {
+        ticks = (0u != ticks_to_wait) ? queue_ticks_left(expiry) : 0u;
+
+        if (0u == ticks)
+        {
+            status = OS_ERROR_QUEUE_EMPTY;
+        }
+        else if (!task_can_wait())
         {
-            if (0u != (queues[id].tasks_waiting & (((uint16_t) (0xFFu & (1u << i))) << 8u)))
+            status = OS_ERROR_TASK_CLASS;
+        }
+        else
+        {
+            // Los emisores solo despiertan a la tarea cuando la queue tiene min_count elementos.
+            tasks[current_task].receive_min = min_count;
+            queue_wait(id, QUEUE_RECEIVER(current_task), ticks);
+        }
+    }
+
+    if (OS_OK == status)
+    {
+        while (num_received < max_count && queues[id].head != queues[id].tail)
+        {
+            i = queues[id].head;
+            ((queue_item_t *) out_items)[num_received] = queues[id].data[i];
+
+            i++;
+            if (QUEUE_LENGTH(id) <= i)
             {
-                // La tarea i estaba esperando a que la queue no estuviera llena. Pasar la tarea i a estado ready.
-                tasks[(task_id_t) i].state = OS_TASK_STATE_READY;
-                tasks[(task_id_t) i].ticks_to_wait = 0u;
+                i = 0u;
             }
+            queues[id].head = i;
+            num_received++;
+        }
+
+        // Despertar a los emisores una vez por todo el lote.
+        queue_wake_senders(id);
+    }
+
+    os_exit_critical();
+
+    if (0 != received)
+    {
+        *received = num_received;
+    }
+
+    return status;
+}
+
+#ifdef OS_QUEUE_ZERO_COPY
+/*
+ * Dirección del espacio index de la queue: el bloque en storage, o el elemento de la queue si no tiene
+ * almacenamiento.
+ */
+static void * queue_slot(queue_id_t id, uint8_t index)
+{
+    if (0 != queues[id].storage)
+    {
+        return queues[id].storage + ((uint16_t) index * queues[id].item_size);
+    }
+
+    return (void *) &queues[id].data[index];
+}
+
+error_id_e os_queue_set_storage(queue_id_t id, void * storage, uint8_t item_size)
+{
+    error_id_e status = OS_OK;
+
+    os_enter_critical();
+
+    if (OS_QUEUE_COUNT_MAX <= id || 0u == (QUEUE_ACCESS(id) & (1u << current_task)) ||
+        (0 != storage && (0u == item_size || 0u != (item_size & 1u) || 0u != ((uintptr_t) storage & 1u))) ||
+        queues[id].head != queues[id].tail || 0u != queues[id].slot_state)
+    {
+        status = OS_ERROR_INVALID_ARGUMENT;
+    }
+    else
+    {
+        queues[id].storage = (uint8_t *) storage;
+        queues[id].item_size = item_size;
+    }
+
+    os_exit_critical();
+
+    return status;
+}
+
+error_id_e os_queue_reserve(queue_id_t id, void ** slot, tick_type_t ticks_to_wait)
+{
+    error_id_e status = OS_OK;
+    os_time_t expiry = os_time_get() + ticks_to_wait;
+    tick_type_t ticks;
+    uint8_t i;
+
+    os_enter_critical();
+
+    if (OS_QUEUE_COUNT_MAX <= id || 0u == (QUEUE_ACCESS(id) & (1u << current_task)) || 0 == slot)
+    {
+        status = OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    while (OS_OK == status)
+    {
+        i = queues[id].tail + 1u;
+        if (QUEUE_LENGTH(id) <= i)
+        {
+            i = 0u;
+        }
+
+        if (i != queues[id].head && !QUEUE_RESERVED(id))
+        {
+            // El espacio en tail queda fuera de la queue hasta os_queue_commit.
+            queues[id].slot_state |= QUEUE_SLOT_RESERVED;
+            *slot = queue_slot(id, queues[id].tail);
+            break;
+        }
+
+        ticks = (0u != ticks_to_wait) ? queue_ticks_left(expiry) : 0u;
+
+        if (0u == ticks)
+        {
+            status = OS_ERROR_QUEUE_FULL;
+        }
+        else if (!task_can_wait())
+        {
+            status = OS_ERROR_TASK_CLASS;
+        }
+        else
+        {
+            queue_wait(id, QUEUE_SENDER(current_task), ticks);
         }
     }
 
-    EM_GLOBAL_INTERRUPT_EN;
+    os_exit_critical();
 
     return status;
 }
 
+error_id_e os_queue_commit(queue_id_t id)
+{
+    error_id_e status = OS_OK;
+    uint8_t i;
+
+    os_enter_critical();
+
+    if (OS_QUEUE_COUNT_MAX <= id || 0u == (QUEUE_ACCESS(id) & (1u << current_task)) || !QUEUE_RESERVED(id))
+    {
+        status = OS_ERROR_INVALID_ARGUMENT;
+    }
+    else
+    {
+        // Con almacenamiento, el elemento de la queue es la dirección del bloque, para os_queue_receive.
+        if (0 != queues[id].storage)
+        {
+            queues[id].data[queues[id].tail] = (queue_item_t) queue_slot(id, queues[id].tail);
+        }
+
+        i = queues[id].tail + 1u;
+        if (QUEUE_LENGTH(id) <= i)
+        {
+            i = 0u;
+        }
+        queues[id].tail = i;
+        queues[id].slot_state &= ~QUEUE_SLOT_RESERVED;
+
+        queue_wake_receivers(id);
+
+        // Otros emisores pudieron esperar por la reserva, no por falta de espacio.
+        queue_wake_senders(id);
+    }
+
+    os_exit_critical();
+
+    return status;
+}
+
+error_id_e os_queue_peek_acquire(queue_id_t id, void ** slot, tick_type_t ticks_to_wait)
+{
+    error_id_e status = OS_OK;
+    os_time_t expiry = os_time_get() + ticks_to_wait;
+    tick_type_t ticks;
+
+    os_enter_critical();
+
+    if (OS_QUEUE_COUNT_MAX <= id || 0u == (QUEUE_ACCESS(id) & (1u << current_task)) || 0 == slot)
+    {
+        status = OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    while (OS_OK == status)
+    {
+        if (queues[id].head != queues[id].tail && !QUEUE_ACQUIRED(id))
+        {
+            // El elemento en head sigue en la queue, pero ningún otro receptor lo ve hasta os_queue_release.
+            queues[id].slot_state |= QUEUE_SLOT_ACQUIRED;
+            *slot = queue_slot(id, queues[id].head);
+            break;
+        }
+
+        ticks = (0u != ticks_to_wait) ? queue_ticks_left(expiry) : 0u;
+
+        if (0u == ticks)
+        {
+            status = OS_ERROR_QUEUE_EMPTY;
+        }
+        else if (!task_can_wait())
+        {
+            status = OS_ERROR_TASK_CLASS;
+        }
+        else
+        {
+            tasks[current_task].receive_min = 1u;
+            queue_wait(id, QUEUE_RECEIVER(current_task), ticks);
+        }
+    }
+
+    os_exit_critical();
+
+    return status;
+}
+
+error_id_e os_queue_release(queue_id_t id)
+{
+    error_id_e status = OS_OK;
+    uint8_t i;
+
+    os_enter_critical();
+
+    if (OS_QUEUE_COUNT_MAX <= id || 0u == (QUEUE_ACCESS(id) & (1u << current_task)) || !QUEUE_ACQUIRED(id))
+    {
+        status = OS_ERROR_INVALID_ARGUMENT;
+    }
+    else
+    {
+        i = queues[id].head + 1u;
+        if (QUEUE_LENGTH(id) <= i)
+        {
+            i = 0u;
+        }
+        queues[id].head = i;
+        queues[id].slot_state &= ~QUEUE_SLOT_ACQUIRED;
+
+        queue_wake_senders(id);
+
+        // Otros receptores pudieron esperar por el elemento tomado, no por falta de elementos.
+        queue_wake_receivers(id);
+    }
+
+    os_exit_critical();
+
+    return status;
+}
+#endif /* OS_QUEUE_ZERO_COPY */
+
+#ifdef OS_COROUTINES
+error_id_e os_co_queue_receive(os_co_t * co, queue_id_t id, void * out_item, tick_type_t ticks_to_wait)
+{
+    volatile register error_id_e status = OS_OK;
+    volatile register uint8_t i;
+
+    os_enter_critical();
+
+    if (OS_QUEUE_COUNT_MAX <= id || 0u == (QUEUE_ACCESS(id) & (1u << current_task)))
+    {
+        status = OS_ERROR_INVALID_ARGUMENT;
+    }
+    else if (OS_TASK_CLASS_COROUTINE != TASK_CONFIG(current_task).task_class)
+    {
+        status = OS_ERROR_TASK_CLASS;
+    }
+
+    if (OS_OK == status && co->waiting)
+    {
+        // La corrutina continúa después de esperar. Llega a este punto si expiró el timeout o queue recibió un elemento.
+        co->waiting = 0u;
+        queues[id].tasks_waiting &= ~((uint16_t) (0xFFu & (1u << current_task)));
+
+        if (queues[id].head == queues[id].tail || QUEUE_ACQUIRED(id))
+        {
+            status = OS_ERROR_QUEUE_EMPTY;
+        }
+    }
+    else if (OS_OK == status && (queues[id].head == queues[id].tail || QUEUE_ACQUIRED(id)))
+    {
+        if (0u != ticks_to_wait)
+        {
+            // Queue está vacía. La corrutina retorna al scheduler y continúa cuando queue tenga un elemento o al timeout.
+            queues[id].tasks_waiting |= ((uint16_t) (0xFFu & (1u << current_task)));
+            tasks[current_task].receive_min = 1u;
+            tasks[current_task].state = OS_TASK_STATE_WAIT;
+            tasks[current_task].ticks_to_wait = ticks_to_wait;
+            co->waiting = 1u;
+
+            status = OS_PENDING;
+        }
+        else
+        {
+            status = OS_ERROR_QUEUE_EMPTY;
+        }
+    }
+
+    if (OS_OK == status)
+    {
+        // Queue tiene al menos un elemento. Remover el elemento de la queue.
+        i = queues[id].head;
+        *((queue_item_t *) out_item) = queues[id].data[i];
+
+        i++;
+        if (QUEUE_LENGTH(id) <= i)
+        {
+            i = 0u;
+        }
+        queues[id].head = i;
+
+        // Revisar si remover el elemento desbloquea alguna tarea (queue ya no está llena).
+        queue_wake_senders(id);
+    }
+
+    os_exit_critical();
+
+    return status;
+}
+#endif /* OS_COROUTINES */
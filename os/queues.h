@@ -15,44 +15,197 @@
 
 typedef uint8_t queue_id_t;
 
+#ifndef OS_STATIC_CONFIG
 /**
  * @brief Registra una nueva queue en el sistema operativo.
  *
- * @param id Identificador nico de la queue.
- * @param length Nmero de elementos almacenados en la queue. Debe ser menor que OS_QUEUE_LEN_MAX.
- * @param access Campo de bits con permisos de acceso para cada tarea. Una tarea tiene permiso si su bit est en 1.
+ * Con OS_STATIC_CONFIG las queues se definen en app.oil y no hace falta inicializarlas.
  *
- * @return OS_OK si el OS inicializ la queue.
- *         OS_INVALID_ARGUMENT si uno de los parmetros es incorrecto.
+ * @param id Identificador único de la queue.
+ * @param length Número de elementos almacenados en la queue. Debe ser menor que OS_QUEUE_LEN_MAX.
+ * @param access Campo de bits con permisos de acceso para cada tarea. Una tarea tiene permiso si su bit está en 1.
+ *
+ * @return OS_OK si el OS inicializó la queue.
+ *         OS_INVALID_ARGUMENT si uno de los parámetros es incorrecto.
  */
 error_id_e os_queue_init(queue_id_t id, uint8_t length, uint8_t access);
+#endif /* OS_STATIC_CONFIG */
 
 /**
- * @brief Enva un elemento al final de la queue.
+ * @brief Envía un elemento al final de la queue.
+ *
+ * Cada elemento es un puntero, o un valor del tamaño de un puntero (16 bits en el MSP430). El receptor debe recibirlo
+ * en una variable de ese tamaño, por ejemplo un puntero o un uintptr_t.
  *
- * @param id Identificador nico de la queue.
- * @param item Elemento que ser enviado a la queue.
- * @param ticks_to_wait Ticks que espera la tarea si la queue est llena. Asignar 0 hace que
+ * @param id Identificador único de la queue.
+ * @param item Elemento que será enviado a la queue.
+ * @param ticks_to_wait Ticks que espera la tarea si la queue está llena. Asignar 0 hace que
  * el servicio regrese inmediatamente.
  *
- * @return OS_OK si envi el elemento a la queue.
- *         OS_INVALID_ARGUMENT si uno de los parmetros es incorrecto.
- *         OS_QUEUE_FULL si la queue est llena y no envi el elemento. Tarea puede haber esperado ticks_to_wait.
+ * @return OS_OK si envió el elemento a la queue.
+ *         OS_INVALID_ARGUMENT si uno de los parámetros es incorrecto.
+ *         OS_QUEUE_FULL si la queue está llena y no envió el elemento. Tarea puede haber esperado ticks_to_wait.
+ *         OS_ERROR_TASK_CLASS si la queue está llena, ticks_to_wait no es 0 y la tarea actual es una tarea básica
+ *         o una corrutina.
  */
 error_id_e os_queue_send(queue_id_t id, const void * item, tick_type_t ticks_to_wait);
 
+/**
+ * @brief Envía un elemento al final de la queue desde una ISR, sin esperar. No revisa los permisos de acceso.
+ *
+ * Si una tarea esperaba un elemento, pasa a estado ready y el cambio de contexto ocurre cuando la ISR termina. La ISR
+ * debe estar declarada con OS_ISR en os/port.asm.
+ *
+ * @param id Identificador único de la queue.
+ * @param item Elemento que será enviado a la queue.
+ *
+ * @return OS_OK si envió el elemento a la queue.
+ *         OS_INVALID_ARGUMENT si id no es un identificador válido.
+ *         OS_QUEUE_FULL si la queue está llena y no envió el elemento.
+ */
+error_id_e os_queue_send_from_isr(queue_id_t id, const void * item);
+
 /**
  * @brief Recibe un elemento del comienzo de la queue.
  *
- * @param id Identificador nico de la queue.
+ * @param id Identificador único de la queue.
  * @param item Espacio para recibir el elemento desde la queue.
- * @param ticks_to_wait Ticks que espera la tarea si la queue est vaca. Asignar 0 hace que
+ * @param ticks_to_wait Ticks que espera la tarea si la queue está vacía. Asignar 0 hace que
  * el servicio regrese inmediatamente.
  *
- * @return OS_OK si recibi un elemento de la queue.
- *         OS_INVALID_ARGUMENT si uno de los parmetros es incorrecto.
- *         OS_QUEUE_FULL si la queue est vaca y no recibi el elemento. Tarea puede haber esperado ticks_to_wait.
+ * @return OS_OK si recibió un elemento de la queue.
+ *         OS_INVALID_ARGUMENT si uno de los parámetros es incorrecto.
+ *         OS_QUEUE_FULL si la queue está vacía y no recibió el elemento. Tarea puede haber esperado ticks_to_wait.
+ *         OS_ERROR_TASK_CLASS si la queue está vacía, ticks_to_wait no es 0 y la tarea actual es una tarea básica
+ *         o una corrutina (las corrutinas esperan con OS_CO_WAIT_QUEUE).
  */
 error_id_e os_queue_receive(queue_id_t id, void * out_item, tick_type_t ticks_to_wait);
 
+/**
+ * @brief Envía varios elementos al final de la queue en una sola sección crítica.
+ *
+ * Agrega todos los elementos que caben y despierta una sola vez a las tareas que esperaban elementos. Si la queue se
+ * llena y ticks_to_wait no es 0, la tarea espera espacio libre y continúa hasta enviar count elementos o hasta que
+ * expira el timeout.
+ *
+ * @param id Identificador único de la queue.
+ * @param items Arreglo con count elementos, del mismo tipo que item en os_queue_send.
+ * @param count Número de elementos en items.
+ * @param sent Espacio para recibir el número de elementos enviados, o 0 si no hace falta.
+ * @param ticks_to_wait Ticks que puede esperar la tarea en total si la queue está llena.
+ *
+ * @return OS_OK si envió los count elementos.
+ *         OS_INVALID_ARGUMENT si uno de los parámetros es incorrecto.
+ *         OS_QUEUE_FULL si no envió todos los elementos. sent indica cuántos envió.
+ *         OS_ERROR_TASK_CLASS si la queue está llena, ticks_to_wait no es 0 y la tarea actual no es una tarea extendida.
+ */
+error_id_e os_queue_send_many(queue_id_t id, const void * items, uint8_t count, uint8_t * sent,
+                              tick_type_t ticks_to_wait);
+
+/**
+ * @brief Recibe varios elementos del comienzo de la queue en una sola sección crítica.
+ *
+ * Si la queue tiene menos de min_count elementos y ticks_to_wait no es 0, la tarea espera a que tenga min_count
+ * elementos; los emisores no la despiertan antes. Después recibe todos los elementos disponibles, hasta max_count, y
+ * despierta una sola vez a las tareas que esperaban espacio libre.
+ *
+ * @param id Identificador único de la queue.
+ * @param out_items Arreglo con espacio para max_count elementos, del mismo tipo que out_item en os_queue_receive.
+ * @param max_count Número máximo de elementos que recibe.
+ * @param min_count Número mínimo de elementos que recibe (1 a la longitud de la queue).
+ * @param received Espacio para recibir el número de elementos recibidos, o 0 si no hace falta.
+ * @param ticks_to_wait Ticks que puede esperar la tarea en total si la queue tiene menos de min_count elementos.
+ *
+ * @return OS_OK si recibió entre min_count y max_count elementos.
+ *         OS_INVALID_ARGUMENT si uno de los parámetros es incorrecto.
+ *         OS_ERROR_QUEUE_EMPTY si la queue tiene menos de min_count elementos. No recibe ningún elemento.
+ *         OS_ERROR_TASK_CLASS si hace falta esperar y la tarea actual no es una tarea extendida.
+ */
+error_id_e os_queue_receive_many(queue_id_t id, void * out_items, uint8_t max_count, uint8_t min_count,
+                                 uint8_t * received, tick_type_t ticks_to_wait);
+
+#ifdef OS_QUEUE_ZERO_COPY
+/*
+ * Acceso directo a los espacios de la queue. Un emisor reserva el siguiente espacio libre, escribe el elemento ahí y lo
+ * publica con os_queue_commit. Un receptor toma el primer elemento sin sacarlo de la queue, lo procesa en su lugar y
+ * libera el espacio con os_queue_release.
+ *
+ * Sin almacenamiento, cada espacio es el elemento de la queue. Con os_queue_set_storage, cada espacio es un
+ * bloque de item_size bytes del almacenamiento de la aplicación (por ejemplo, un paquete de la UART), y os_queue_receive
+ * entrega la dirección del bloque. Ese bloque puede reservarse otra vez en cuanto sale de la queue, entonces para
+ * procesarlo en su lugar el receptor debe usar os_queue_peek_acquire.
+ *
+ * Mientras un espacio está reservado, la queue está llena para los demás emisores; mientras un elemento está tomado,
+ * la queue está vacía para los demás receptores. Cada queue tiene como máximo una reserva y un elemento tomado.
+ */
+
+/*
+ * Bytes de almacenamiento para una queue de length elementos de item_size bytes. La queue tiene length + 1 espacios
+ * para distinguir una queue llena de una vacía; si queues.c deja de usar ese espacio extra, este tamaño debe cambiar.
+ */
+#define OS_QUEUE_STORAGE_SIZE(length, item_size)    (((length) + 1u) * (item_size))
+
+/**
+ * @brief Asigna almacenamiento de la aplicación a los espacios de la queue. La queue debe estar vacía.
+ *
+ * @param id Identificador único de la queue.
+ * @param storage Arreglo de OS_QUEUE_STORAGE_SIZE(length, item_size) bytes, alineado a 2 bytes, o 0 para que cada
+ * espacio vuelva a ser el elemento de la queue.
+ * @param item_size Bytes de cada espacio. Debe ser par.
+ *
+ * @return OS_OK si la queue usa el almacenamiento.
+ *         OS_INVALID_ARGUMENT si uno de los parámetros es incorrecto o la queue no está vacía.
+ */
+error_id_e os_queue_set_storage(queue_id_t id, void * storage, uint8_t item_size);
+
+/**
+ * @brief Reserva el siguiente espacio libre al final de la queue. Los receptores no ven el elemento hasta
+ * os_queue_commit.
+ *
+ * @param id Identificador único de la queue.
+ * @param slot Espacio para recibir la dirección del espacio reservado.
+ * @param ticks_to_wait Ticks que espera la tarea si la queue está llena o tiene otra reserva.
+ *
+ * @return OS_OK si reservó el espacio.
+ *         OS_INVALID_ARGUMENT si uno de los parámetros es incorrecto.
+ *         OS_QUEUE_FULL si no hay espacio libre. Tarea puede haber esperado ticks_to_wait.
+ *         OS_ERROR_TASK_CLASS si hace falta esperar y la tarea actual no es una tarea extendida.
+ */
+error_id_e os_queue_reserve(queue_id_t id, void ** slot, tick_type_t ticks_to_wait);
+
+/**
+ * @brief Publica el espacio reservado con os_queue_reserve al final de la queue.
+ *
+ * @param id Identificador único de la queue.
+ *
+ * @return OS_OK si publicó el elemento.
+ *         OS_INVALID_ARGUMENT si id no es válido o la queue no tiene un espacio reservado.
+ */
+error_id_e os_queue_commit(queue_id_t id);
+
+/**
+ * @brief Toma el primer elemento de la queue sin sacarlo. El espacio no se libera hasta os_queue_release.
+ *
+ * @param id Identificador único de la queue.
+ * @param slot Espacio para recibir la dirección del elemento.
+ * @param ticks_to_wait Ticks que espera la tarea si la queue está vacía o tiene otro elemento tomado.
+ *
+ * @return OS_OK si tomó el elemento.
+ *         OS_INVALID_ARGUMENT si uno de los parámetros es incorrecto.
+ *         OS_ERROR_QUEUE_EMPTY si la queue está vacía. Tarea puede haber esperado ticks_to_wait.
+ *         OS_ERROR_TASK_CLASS si hace falta esperar y la tarea actual no es una tarea extendida.
+ */
+error_id_e os_queue_peek_acquire(queue_id_t id, void ** slot, tick_type_t ticks_to_wait);
+
+/**
+ * @brief Saca de la queue el elemento tomado con os_queue_peek_acquire y libera su espacio.
+ *
+ * @param id Identificador único de la queue.
+ *
+ * @return OS_OK si liberó el espacio.
+ *         OS_INVALID_ARGUMENT si id no es válido o la queue no tiene un elemento tomado.
+ */
+error_id_e os_queue_release(queue_id_t id);
+#endif /* OS_QUEUE_ZERO_COPY */
+
 #endif /* OS_QUEUES_H_ */
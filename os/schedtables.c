@@ -0,0 +1,174 @@
+/*
+ * schedtables.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include "schedtables.h"
+#include "critical.h"
+
+#include "os_private.h"
+
+#ifdef OS_SCHEDULE_TABLES
+
+#define SCHEDTABLE_RUNNING  (0x01u)
+
+typedef struct _schedtable_state_t {
+    uint16_t count;                     /* Ticks restantes para el siguiente punto de expiración. */
+    uint8_t next_point;                 /* Índice del siguiente punto de expiración. */
+    uint8_t state;
+} schedtable_state_t;
+
+static volatile schedtable_state_t schedtables[OS_SCHEDTABLE_COUNT];
+
+/*
+ * Revisa que los offsets de la tabla no decrezcan y que su periodo sea mayor que el último offset. Con otra tabla, el
+ * contador de schedtable_tick daría la vuelta o quedaría en 0 en cada periodo.
+ */
+static uint8_t schedtable_is_valid(const os_schedtable_t * table)
+{
+    uint8_t point;
+
+    if (0 == table->points || 0u == table->num_points)
+    {
+        return 0u;
+    }
+
+    for (point = 1u; point < table->num_points; point++)
+    {
+        if (table->points[point].offset < table->points[point - 1u].offset)
+        {
+            return 0u;
+        }
+    }
+
+    return (table->duration > table->points[table->num_points - 1u].offset);
+}
+
+error_id_e os_schedtable_start_rel(schedtable_id_t id, tick_type_t offset)
+{
+    error_id_e status = OS_OK;
+
+    if (OS_SCHEDTABLE_COUNT <= id || 0u == offset || !schedtable_is_valid(&os_schedtables[id]) ||
+        OS_MAX_TICKS - offset < os_schedtables[id].points[0].offset)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    os_enter_tick_critical();
+
+    if (SCHEDTABLE_RUNNING & schedtables[id].state)
+    {
+        status = OS_ERROR_INVALID_ARGUMENT;
+    }
+    else
+    {
+        schedtables[id] = (schedtable_state_t) {
+            .count = offset + os_schedtables[id].points[0].offset,
+            .next_point = 0u,
+            .state = SCHEDTABLE_RUNNING,
+        };
+    }
+
+    os_exit_tick_critical();
+
+    return status;
+}
+
+error_id_e os_schedtable_stop(schedtable_id_t id)
+{
+    if (OS_SCHEDTABLE_COUNT <= id)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    schedtables[id].state &= ~SCHEDTABLE_RUNNING;
+
+    return OS_OK;
+}
+
+uint8_t schedtable_tick(void)
+{
+    uint8_t task_activated = 0u;
+    uint8_t i;
+    uint8_t point;
+    uint8_t task_id;
+
+    i = OS_SCHEDTABLE_COUNT;
+    while (i--)
+    {
+        if (0u == (SCHEDTABLE_RUNNING & schedtables[i].state) || 0u != (--schedtables[i].count))
+        {
+            continue;
+        }
+
+        // Procesar el punto de expiración actual y los puntos siguientes que tengan el mismo offset.
+        do
+        {
+            point = schedtables[i].next_point;
+
+            task_id = NUM_TASK_MAX;
+            while (task_id--)
+            {
+                if (os_schedtables[i].points[point].tasks_to_activate & (1u << task_id))
+                {
+                    task_activated |= (OS_OK == task_activate((task_id_t) task_id));
+                }
+            }
+
+            if (os_schedtables[i].num_points > (point + 1u))
+            {
+                schedtables[i].next_point = point + 1u;
+                schedtables[i].count = os_schedtables[i].points[point + 1u].offset -
+                                       os_schedtables[i].points[point].offset;
+            }
+            else if (os_schedtables[i].repeating)
+            {
+                // El siguiente punto es el primero del siguiente periodo de la tabla.
+                schedtables[i].next_point = 0u;
+                schedtables[i].count = os_schedtables[i].duration - os_schedtables[i].points[point].offset +
+                                       os_schedtables[i].points[0].offset;
+            }
+            else
+            {
+                schedtables[i].state &= ~SCHEDTABLE_RUNNING;
+            }
+        } while ((SCHEDTABLE_RUNNING & schedtables[i].state) && 0u == schedtables[i].count);
+    }
+
+    return task_activated;
+}
+
+#ifdef OS_LOW_POWER_IDLE
+void schedtable_next_event(tick_type_t * next)
+{
+    uint8_t i;
+
+    i = OS_SCHEDTABLE_COUNT;
+    while (i--)
+    {
+        if (SCHEDTABLE_RUNNING & schedtables[i].state)
+        {
+            OS_NEXT_EVENT(*next, schedtables[i].count);
+        }
+    }
+}
+
+#ifdef OS_IDLE_TICKLESS
+void schedtable_skip(tick_type_t ticks)
+{
+    uint8_t i;
+
+    i = OS_SCHEDTABLE_COUNT;
+    while (i--)
+    {
+        if (SCHEDTABLE_RUNNING & schedtables[i].state)
+        {
+            schedtables[i].count -= ticks;
+        }
+    }
+}
+#endif /* OS_IDLE_TICKLESS */
+#endif /* OS_LOW_POWER_IDLE */
+
+#endif /* OS_SCHEDULE_TABLES */
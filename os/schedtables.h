@@ -0,0 +1,73 @@
+/*
+ * schedtables.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+
+#ifndef OS_SCHEDTABLES_H_
+#define OS_SCHEDTABLES_H_
+
+#include <stdint.h>
+
+#include "os.h"
+#include "os_config.h"
+
+typedef uint8_t schedtable_id_t;
+
+typedef struct _os_schedtable_point_t {
+    tick_type_t offset;                 /* Ticks desde el inicio del periodo de la tabla hasta este punto. */
+    uint8_t tasks_to_activate;          /* Campo de bits con las tareas que activa este punto (bit n = tarea n). */
+} os_schedtable_point_t;
+
+typedef struct _os_schedtable_t {
+    const os_schedtable_point_t * points;   /* Puntos de expiración, ordenados por offset (no decreciente). */
+    uint8_t num_points;                     /* Número de puntos de expiración en points. */
+    tick_type_t duration;                   /* Periodo de la tabla, en ticks. Debe ser mayor que el último offset. */
+    uint8_t repeating;                      /* Si es distinto de 0, la tabla vuelve a iniciar al terminar su periodo. */
+} os_schedtable_t;
+
+/*
+ * Tablas de activación de la aplicación, indexadas por schedtable_id_t. La aplicación debe definir este arreglo como
+ * const para que quede en flash, por ejemplo:
+ *
+ * static const os_schedtable_point_t control_points[] = {
+ *     { .offset = 0u,  .tasks_to_activate = (1u << TASK_10MS) | (1u << TASK_20MS) | (1u << TASK_50MS) },
+ *     { .offset = 10u, .tasks_to_activate = (1u << TASK_10MS) },
+ *     ...
+ * };
+ *
+ * const os_schedtable_t os_schedtables[OS_SCHEDTABLE_COUNT] = {
+ *     { .points = control_points, .num_points = 7u, .duration = 100u, .repeating = 1u },
+ * };
+ */
+#ifdef OS_SCHEDULE_TABLES
+extern const os_schedtable_t os_schedtables[OS_SCHEDTABLE_COUNT];
+#endif /* OS_SCHEDULE_TABLES */
+
+/**
+ * @brief Inicia una tabla de activación. El periodo de la tabla comienza offset ticks después del tick actual.
+ *
+ * Todos los puntos de expiración de la tabla se procesan con un solo contador, entonces las tareas que activa
+ * mantienen su fase relativa entre sí.
+ *
+ * @param id Identificador único de la tabla, índice en os_schedtables.
+ * @param offset Ticks hasta el inicio del periodo de la tabla. Debe ser mayor que 0.
+ *
+ * @return OS_OK si el OS inició la tabla.
+ *         OS_ERROR_INVALID_ARGUMENT si id u offset tienen valores inválidos, si los offsets de la tabla no están
+ *         ordenados o su periodo no es mayor que el último offset, o si la tabla ya está en ejecución.
+ */
+error_id_e os_schedtable_start_rel(schedtable_id_t id, tick_type_t offset);
+
+/**
+ * @brief Detiene una tabla de activación. Los puntos de expiración pendientes no activan tareas.
+ *
+ * @param id Identificador único de la tabla.
+ *
+ * @return OS_OK si el OS detuvo la tabla.
+ *         OS_ERROR_INVALID_ARGUMENT si id no es un identificador válido.
+ */
+error_id_e os_schedtable_stop(schedtable_id_t id);
+
+#endif /* OS_SCHEDTABLES_H_ */
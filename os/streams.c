@@ -0,0 +1,276 @@
+/*
+ * streams.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include "streams.h"
+#include "critical.h"
+#include "systime.h"
+
+#include "os_private.h"
+
+#ifdef OS_STREAM_BUFFERS
+
+#define STREAM_NO_TASK      (0xFFu)
+
+/*
+ * head y tail son índices libres (no se reinician al llegar a size): head - tail es el número de bytes en el stream.
+ * Cada lado lee el índice del otro una vez y publica el suyo hasta después de copiar los datos.
+ */
+static uint8_t stream_put(os_stream_t * stream, const uint8_t * data, uint8_t len)
+{
+    uint8_t head = stream->head;
+    uint8_t space = stream->size - (uint8_t) (head - stream->tail);
+    uint8_t i;
+
+    if (len > space)
+    {
+        len = space;
+    }
+
+    for (i = 0u; i < len; i++)
+    {
+        stream->storage[head & (stream->size - 1u)] = data[i];
+        head++;
+    }
+
+    stream->head = head;
+
+    return len;
+}
+
+static uint8_t stream_get(os_stream_t * stream, uint8_t * out_data, uint8_t max_len)
+{
+    uint8_t tail = stream->tail;
+    uint8_t count = (uint8_t) (stream->head - tail);
+    uint8_t i;
+
+    if (max_len > count)
+    {
+        max_len = count;
+    }
+
+    for (i = 0u; i < max_len; i++)
+    {
+        out_data[i] = stream->storage[tail & (stream->size - 1u)];
+        tail++;
+    }
+
+    stream->tail = tail;
+
+    return max_len;
+}
+
+/*
+ * Pasa a estado ready la tarea que esperaba en el stream. Se llama con interrupciones desactivadas.
+ */
+static void stream_wake(volatile uint8_t * waiting)
+{
+    tasks[*waiting].state = OS_TASK_STATE_READY;
+    tasks[*waiting].ticks_to_wait = 0u;
+    *waiting = STREAM_NO_TASK;
+    os_switch_pending = 1u;
+}
+
+/*
+ * Despierta al lector si espera y el stream ya tiene trigger_level bytes. Se llama con interrupciones desactivadas.
+ */
+static void stream_wake_reader(os_stream_t * stream)
+{
+    if (STREAM_NO_TASK != stream->reader && os_stream_available(stream) >= stream->trigger_level)
+    {
+        stream_wake(&stream->reader);
+    }
+}
+
+/*
+ * Despierta al escritor si espera y el stream tiene espacio libre. Se llama con interrupciones desactivadas.
+ */
+static void stream_wake_writer(os_stream_t * stream)
+{
+    if (STREAM_NO_TASK != stream->writer && os_stream_available(stream) < stream->size)
+    {
+        stream_wake(&stream->writer);
+    }
+}
+
+/*
+ * Espera en el stream hasta ticks ticks, con la tarea actual en waiting. Se llama dentro de una sección crítica.
+ */
+static void stream_wait(volatile uint8_t * waiting, tick_type_t ticks)
+{
+    *waiting = current_task;
+    tasks[current_task].state = OS_TASK_STATE_WAIT;
+    tasks[current_task].ticks_to_wait = ticks;
+
+    scheduler_run();
+
+    *waiting = STREAM_NO_TASK;
+}
+
+error_id_e os_stream_init(os_stream_t * stream, uint8_t * storage, uint8_t size, uint8_t trigger_level)
+{
+    if (0 == stream || 0 == storage || 0u == size || 128u < size || 0u != (size & (size - 1u)) ||
+        0u == trigger_level || size < trigger_level)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    *stream = (os_stream_t) {
+        .storage = storage,
+        .size = size,
+        .trigger_level = trigger_level,
+        .head = 0u,
+        .tail = 0u,
+        .reader = STREAM_NO_TASK,
+        .writer = STREAM_NO_TASK,
+    };
+
+    return OS_OK;
+}
+
+uint8_t os_stream_available(const os_stream_t * stream)
+{
+    return (uint8_t) (stream->head - stream->tail);
+}
+
+error_id_e os_stream_write(os_stream_t * stream, const uint8_t * data, uint8_t len, uint8_t * written,
+                           tick_type_t ticks_to_wait)
+{
+    error_id_e status = OS_OK;
+    os_time_t expiry = 0u;
+    int32_t ticks;
+    uint8_t num_written = 0u;
+
+    if (0 == stream || 0 == data)
+    {
+        status = OS_ERROR_INVALID_ARGUMENT;
+    }
+    else if (0u != ticks_to_wait)
+    {
+        expiry = os_time_get() + ticks_to_wait;
+    }
+
+    while (OS_OK == status)
+    {
+        num_written += stream_put(stream, &data[num_written], len - num_written);
+
+        // El camino común no desactiva interrupciones: solo hace falta una sección crítica si el lector espera.
+        if (STREAM_NO_TASK != stream->reader)
+        {
+            os_enter_critical();
+            stream_wake_reader(stream);
+            os_exit_critical();
+        }
+
+        if (len == num_written)
+        {
+            break;
+        }
+
+        ticks = (0u != ticks_to_wait) ? (int32_t) (expiry - os_time_get()) : 0;
+
+        if (0 >= ticks)
+        {
+            status = OS_ERROR_QUEUE_FULL;
+        }
+        else if (!task_can_wait())
+        {
+            status = OS_ERROR_TASK_CLASS;
+        }
+        else
+        {
+            os_enter_critical();
+
+            // El lector pudo liberar espacio después de stream_put.
+            if (stream->size == os_stream_available(stream))
+            {
+                stream_wait(&stream->writer, (tick_type_t) ticks);
+            }
+
+            os_exit_critical();
+        }
+    }
+
+    if (0 != written)
+    {
+        *written = num_written;
+    }
+
+    return status;
+}
+
+error_id_e os_stream_read(os_stream_t * stream, uint8_t * out_data, uint8_t max_len, uint8_t * read,
+                          tick_type_t ticks_to_wait)
+{
+    error_id_e status = OS_OK;
+    uint8_t num_read = 0u;
+
+    if (0 == stream || 0 == out_data || 0u == max_len)
+    {
+        status = OS_ERROR_INVALID_ARGUMENT;
+    }
+    else if (0u != ticks_to_wait && os_stream_available(stream) < stream->trigger_level)
+    {
+        if (!task_can_wait())
+        {
+            status = OS_ERROR_TASK_CLASS;
+        }
+        else
+        {
+            os_enter_critical();
+
+            // El escritor solo despierta al lector con trigger_level bytes, entonces basta con una espera.
+            if (os_stream_available(stream) < stream->trigger_level)
+            {
+                stream_wait(&stream->reader, ticks_to_wait);
+            }
+
+            os_exit_critical();
+        }
+    }
+
+    if (OS_OK == status)
+    {
+        num_read = stream_get(stream, out_data, max_len);
+
+        if (0u == num_read)
+        {
+            status = OS_ERROR_QUEUE_EMPTY;
+        }
+        else if (STREAM_NO_TASK != stream->writer)
+        {
+            os_enter_critical();
+            stream_wake_writer(stream);
+            os_exit_critical();
+        }
+    }
+
+    if (0 != read)
+    {
+        *read = num_read;
+    }
+
+    return status;
+}
+
+uint8_t os_stream_write_from_isr(os_stream_t * stream, const uint8_t * data, uint8_t len)
+{
+    len = stream_put(stream, data, len);
+
+    stream_wake_reader(stream);
+
+    return len;
+}
+
+uint8_t os_stream_read_from_isr(os_stream_t * stream, uint8_t * out_data, uint8_t max_len)
+{
+    max_len = stream_get(stream, out_data, max_len);
+
+    stream_wake_writer(stream);
+
+    return max_len;
+}
+
+#endif /* OS_STREAM_BUFFERS */
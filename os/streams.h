@@ -0,0 +1,131 @@
+/*
+ * streams.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+
+#ifndef OS_STREAMS_H_
+#define OS_STREAMS_H_
+
+#include <stdint.h>
+
+#include "os.h"
+#include "os_config.h"
+
+/*
+ * Stream buffer: cola circular de bytes con un solo escritor y un solo lector, para flujos de bytes entre una ISR y
+ * una tarea (por ejemplo, la recepción de la UART o muestras del ADC). Escribir y leer no desactiva interrupciones:
+ * solo el escritor modifica head y solo el lector modifica tail. Las secciones críticas solo se usan cuando una tarea
+ * espera o cuando hay que despertar a una tarea en espera. Con varios escritores, el stream necesita una sección
+ * crítica alrededor de cada escritura y deja de ser libre de bloqueos.
+ *
+ * Un lector en espera solo despierta cuando el stream tiene al menos trigger_level bytes (o al expirar su timeout), en
+ * vez de despertar con cada byte. La aplicación define el stream y su almacenamiento:
+ *
+ * static uint8_t rx_storage[32];
+ * static os_stream_t rx_stream;
+ *
+ * os_stream_init(&rx_stream, rx_storage, sizeof(rx_storage), 8u);
+ */
+typedef struct _os_stream_t {
+    uint8_t * storage;                  /* Arreglo de size bytes. */
+    uint8_t size;                       /* Bytes en storage. Potencia de 2, máximo 128. */
+    uint8_t trigger_level;              /* Bytes que necesita un lector en espera para despertar. */
+    volatile uint8_t head;              /* Índice libre del siguiente byte que escribe el escritor. */
+    volatile uint8_t tail;              /* Índice libre del siguiente byte que lee el lector. */
+    volatile uint8_t reader;            /* Tarea que espera bytes, o 0xFF si el lector no espera. */
+    volatile uint8_t writer;            /* Tarea que espera espacio libre, o 0xFF si el escritor no espera. */
+} os_stream_t;
+
+/**
+ * @brief Inicializa un stream vacío.
+ *
+ * @param stream Stream de la aplicación.
+ * @param storage Arreglo de size bytes para los datos del stream.
+ * @param size Bytes en storage. Debe ser una potencia de 2, máximo 128.
+ * @param trigger_level Bytes que necesita un lector en espera para despertar (1 a size).
+ *
+ * @return OS_OK si inicializó el stream.
+ *         OS_ERROR_INVALID_ARGUMENT si uno de los parámetros es incorrecto.
+ */
+error_id_e os_stream_init(os_stream_t * stream, uint8_t * storage, uint8_t size, uint8_t trigger_level);
+
+/**
+ * @brief Número de bytes que puede leer el lector.
+ *
+ * @param stream Stream inicializado con os_stream_init.
+ */
+uint8_t os_stream_available(const os_stream_t * stream);
+
+/**
+ * @brief Escribe bytes al final del stream. Solo una tarea puede escribir en cada stream.
+ *
+ * Escribe todos los bytes que caben. Si el stream se llena y ticks_to_wait no es 0, la tarea espera espacio libre y
+ * continúa hasta escribir len bytes o hasta que expira el timeout.
+ *
+ * @param stream Stream inicializado con os_stream_init.
+ * @param data Bytes que escribe.
+ * @param len Número de bytes en data.
+ * @param written Espacio para recibir el número de bytes escritos, o 0 si no hace falta.
+ * @param ticks_to_wait Ticks que puede esperar la tarea en total si el stream está lleno.
+ *
+ * @return OS_OK si escribió los len bytes.
+ *         OS_ERROR_INVALID_ARGUMENT si uno de los parámetros es incorrecto.
+ *         OS_ERROR_QUEUE_FULL si no escribió todos los bytes. written indica cuántos escribió.
+ *         OS_ERROR_TASK_CLASS si hace falta esperar y la tarea actual no es una tarea extendida (o no hay tarea
+ *         actual, antes de os_init).
+ */
+error_id_e os_stream_write(os_stream_t * stream, const uint8_t * data, uint8_t len, uint8_t * written,
+                           tick_type_t ticks_to_wait);
+
+/**
+ * @brief Lee bytes del comienzo del stream. Solo una tarea puede leer de cada stream.
+ *
+ * Si el stream tiene menos de trigger_level bytes y ticks_to_wait no es 0, la tarea espera a que tenga trigger_level
+ * bytes o a que expire el timeout. Después lee todos los bytes disponibles, hasta max_len.
+ *
+ * @param stream Stream inicializado con os_stream_init.
+ * @param out_data Arreglo con espacio para max_len bytes.
+ * @param max_len Número máximo de bytes que lee.
+ * @param read Espacio para recibir el número de bytes leídos, o 0 si no hace falta.
+ * @param ticks_to_wait Ticks que puede esperar la tarea si el stream tiene menos de trigger_level bytes.
+ *
+ * @return OS_OK si leyó al menos un byte.
+ *         OS_ERROR_INVALID_ARGUMENT si uno de los parámetros es incorrecto.
+ *         OS_ERROR_QUEUE_EMPTY si el stream está vacío. Tarea puede haber esperado ticks_to_wait.
+ *         OS_ERROR_TASK_CLASS si hace falta esperar y la tarea actual no es una tarea extendida (o no hay tarea
+ *         actual, antes de os_init).
+ */
+error_id_e os_stream_read(os_stream_t * stream, uint8_t * out_data, uint8_t max_len, uint8_t * read,
+                          tick_type_t ticks_to_wait);
+
+/**
+ * @brief Escribe bytes al final del stream desde una ISR, sin esperar.
+ *
+ * Si el lector esperaba y el stream llega a trigger_level bytes, pasa a estado ready y el cambio de contexto ocurre
+ * cuando la ISR termina. Para eso la ISR debe estar declarada con OS_ISR en os/port.asm; si no, el cambio ocurre en el
+ * siguiente tick.
+ *
+ * @param stream Stream inicializado con os_stream_init.
+ * @param data Bytes que escribe.
+ * @param len Número de bytes en data.
+ *
+ * @return Número de bytes escritos.
+ */
+uint8_t os_stream_write_from_isr(os_stream_t * stream, const uint8_t * data, uint8_t len);
+
+/**
+ * @brief Lee bytes del comienzo del stream desde una ISR, sin esperar.
+ *
+ * Si el escritor esperaba espacio libre, pasa a estado ready (ver os_stream_write_from_isr).
+ *
+ * @param stream Stream inicializado con os_stream_init.
+ * @param out_data Arreglo con espacio para max_len bytes.
+ * @param max_len Número máximo de bytes que lee.
+ *
+ * @return Número de bytes leídos.
+ */
+uint8_t os_stream_read_from_isr(os_stream_t * stream, uint8_t * out_data, uint8_t max_len);
+
+#endif /* OS_STREAMS_H_ */
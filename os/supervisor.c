@@ -0,0 +1,179 @@
+/*
+ * supervisor.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include <msp430.h>
+
+#include "supervisor.h"
+
+#include "os_private.h"
+
+#ifdef OS_SUPERVISOR
+
+#define SUPERVISOR_MAGIC    (0x5AF3u)
+
+#define SUPERVISOR_RECORD_VALID     (SUPERVISOR_MAGIC == supervisor_record.magic && \
+                                     (uint16_t) ~SUPERVISOR_MAGIC == supervisor_record.magic_inv)
+
+/* El registro está en .TI.noinit: el código de arranque no lo borra, entonces conserva su valor después del reinicio. */
+#pragma NOINIT(supervisor_record)
+static os_fault_record_t supervisor_record;
+
+/* Distinto de 0 si una tarea excedió su intervalo desde os_init. El watchdog ya no se reinicia. */
+static volatile uint8_t supervisor_faulted;
+
+void supervisor_init(void)
+{
+    // El watchdog cuenta con ACLK = VLO, que sigue encendido en LPM3.
+    BCSCTL3 = (BCSCTL3 & ~LFXT1S_3) | LFXT1S_2;
+
+    if ((IFG1 & WDTIFG) && !SUPERVISOR_RECORD_VALID)
+    {
+        // El watchdog reinició el MSP430 sin que el supervisor detectara una tarea: systick dejó de ejecutarse.
+        supervisor_record = (os_fault_record_t) {
+            .magic = SUPERVISOR_MAGIC,
+            .task_id = OS_SUPERVISOR_NO_TASK,
+            .elapsed_ticks = 0u,
+            .time = 0u,
+            .magic_inv = (uint16_t) ~SUPERVISOR_MAGIC,
+        };
+    }
+
+    IFG1 &= ~WDTIFG;
+
+    supervisor_faulted = 0u;
+    WDTCTL = OS_SUPERVISOR_WDT;
+}
+
+void supervisor_tick(void)
+{
+    task_id_t i;
+
+    i = NUM_TASK_MAX;
+    while (i--)
+    {
+        // Las tareas suspendidas no cuentan su intervalo.
+        if (0u == TASK_CONFIG(i).watchdog_ticks || OS_TASK_STATE_SUSPENDED >= tasks[i].state)
+        {
+            continue;
+        }
+
+        if (OS_MAX_TICKS != tasks[i].checkin_ticks)
+        {
+            tasks[i].checkin_ticks++;
+        }
+
+        if (TASK_CONFIG(i).watchdog_ticks >= tasks[i].checkin_ticks)
+        {
+            continue;
+        }
+
+        if (!supervisor_faulted)
+        {
+            // Solo se registra la primera tarea que excede su intervalo.
+            supervisor_faulted = 1u;
+            supervisor_record = (os_fault_record_t) {
+                .magic = SUPERVISOR_MAGIC,
+                .task_id = i,
+                .time = os_tick_count,
+                .magic_inv = (uint16_t) ~SUPERVISOR_MAGIC,
+            };
+        }
+
+        if (i == supervisor_record.task_id)
+        {
+            // Sigue midiendo hasta que el watchdog reinicia el MSP430.
+            supervisor_record.elapsed_ticks = tasks[i].checkin_ticks;
+        }
+    }
+
+    if (!supervisor_faulted)
+    {
+        WDTCTL = OS_SUPERVISOR_WDT;
+    }
+}
+
+void os_supervisor_checkin(void)
+{
+    if (OS_TASK_ID_MAX != current_task)
+    {
+        tasks[current_task].checkin_ticks = 0u;
+    }
+}
+
+uint8_t os_supervisor_get_fault(os_fault_record_t * record)
+{
+    if (0 == record || !SUPERVISOR_RECORD_VALID)
+    {
+        return 0u;
+    }
+
+    *record = supervisor_record;
+
+    return 1u;
+}
+
+void os_supervisor_clear_fault(void)
+{
+    supervisor_record.magic = 0u;
+}
+
+#ifdef OS_LOW_POWER_IDLE
+void supervisor_next_event(tick_type_t * next)
+{
+    task_id_t i;
+
+    if (supervisor_faulted)
+    {
+        return;
+    }
+
+    i = NUM_TASK_MAX;
+    while (i--)
+    {
+        if (0u != TASK_CONFIG(i).watchdog_ticks && OS_TASK_STATE_SUSPENDED < tasks[i].state &&
+            TASK_CONFIG(i).watchdog_ticks >= tasks[i].checkin_ticks)
+        {
+            // Tick en el que la tarea excede su intervalo.
+            OS_NEXT_EVENT(*next, TASK_CONFIG(i).watchdog_ticks - tasks[i].checkin_ticks + 1u);
+        }
+    }
+}
+
+void supervisor_suspend(void)
+{
+    // systick no reinicia el watchdog mientras el CPU duerme sin ticks. Con una falla, el watchdog sigue contando.
+    if (!supervisor_faulted)
+    {
+        WDTCTL = WDTPW | WDTHOLD;
+    }
+}
+
+void supervisor_resume(void)
+{
+    if (!supervisor_faulted)
+    {
+        WDTCTL = OS_SUPERVISOR_WDT;
+    }
+}
+
+#ifdef OS_IDLE_TICKLESS
+void supervisor_skip(tick_type_t ticks)
+{
+    task_id_t i;
+
+    i = NUM_TASK_MAX;
+    while (i--)
+    {
+        if (0u != TASK_CONFIG(i).watchdog_ticks && OS_TASK_STATE_SUSPENDED < tasks[i].state)
+        {
+            tasks[i].checkin_ticks += ticks;
+        }
+    }
+}
+#endif /* OS_IDLE_TICKLESS */
+#endif /* OS_LOW_POWER_IDLE */
+
+#endif /* OS_SUPERVISOR */
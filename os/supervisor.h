@@ -0,0 +1,60 @@
+/*
+ * supervisor.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+
+#ifndef OS_SUPERVISOR_H_
+#define OS_SUPERVISOR_H_
+
+#include <stdint.h>
+
+#include "os.h"
+#include "os_config.h"
+#include "systime.h"
+
+/*
+ * Supervisor de tareas con el watchdog del MSP430. Cada tarea supervisada tiene un intervalo máximo en ticks
+ * (os_task_set_watchdog, o WATCHDOG en app.oil) entre su activación o su último reporte (os_supervisor_checkin) y su
+ * siguiente reporte o su terminación. El intervalo solo cuenta mientras la tarea está activa, incluyendo el tiempo
+ * en estado wait: una tarea extendida que espera más que su intervalo debe reportarse antes de esperar o no estar
+ * supervisada.
+ *
+ * systick revisa los intervalos en cada tick y reinicia el watchdog solo si ninguna tarea excedió el suyo. Cuando una
+ * tarea lo excede, el supervisor guarda un registro en RAM sin inicializar y deja que el watchdog reinicie el MSP430.
+ * Si systick deja de ejecutarse (por ejemplo, con interrupciones desactivadas), el watchdog también reinicia el MSP430.
+ * Después del reinicio, la aplicación lee el registro con os_supervisor_get_fault.
+ */
+
+/* task_id del registro cuando el watchdog reinició el MSP430 sin que una tarea excediera su intervalo. */
+#define OS_SUPERVISOR_NO_TASK   (0xFFu)
+
+typedef struct _os_fault_record_t {
+    uint16_t magic;                     /* Valor fijo que indica un registro válido. */
+    uint8_t task_id;                    /* Tarea que excedió su intervalo, u OS_SUPERVISOR_NO_TASK. */
+    uint16_t elapsed_ticks;             /* Ticks desde el último reporte de la tarea hasta el último tick antes del reinicio. */
+    os_time_t time;                     /* Tiempo del sistema cuando la tarea excedió su intervalo. */
+    uint16_t magic_inv;                 /* Complemento de magic. */
+} os_fault_record_t;
+
+/**
+ * @brief Reporta al supervisor que la tarea actual sigue funcionando. Reinicia su intervalo.
+ */
+void os_supervisor_checkin(void);
+
+/**
+ * @brief Obtiene el registro de la última falla que detectó el supervisor, que sobrevive al reinicio por watchdog.
+ *
+ * @param record Espacio para recibir el registro.
+ *
+ * @return 1 si hay un registro, 0 si no.
+ */
+uint8_t os_supervisor_get_fault(os_fault_record_t * record);
+
+/**
+ * @brief Borra el registro de falla, para distinguir la siguiente falla de la anterior.
+ */
+void os_supervisor_clear_fault(void);
+
+#endif /* OS_SUPERVISOR_H_ */
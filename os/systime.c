@@ -0,0 +1,51 @@
+/*
+ * systime.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+#include "systime.h"
+
+#include "os_private.h"
+
+volatile os_time_t os_tick_count;
+
+os_time_t os_time_get(void)
+{
+    // Solo systick_isr modifica la cuenta. El MSP430 lee 16 bits a la vez, entonces si el incremento acarrea a la
+    // palabra alta entre las dos lecturas, la palabra alta cambia y hay que volver a leer.
+    volatile uint16_t * const count_words = (volatile uint16_t *) &os_tick_count;
+    uint16_t high;
+    uint16_t low;
+
+    do
+    {
+        high = count_words[1];
+        low = count_words[0];
+    } while (high != count_words[1]);
+
+    return ((os_time_t) high << 16) | low;
+}
+
+os_timestamp_t os_timestamp_get(void)
+{
+    os_time_t ticks;
+    uint16_t last_tick_count;
+    uint16_t timer_count;
+
+    do
+    {
+        ticks = os_time_get();
+        // SYSTICK_CCR tiene la cuenta del siguiente tick, entonces el último tick procesado fue un periodo antes.
+        // dvfs_tick solo cambia el periodo en systick_isr, después de incrementar la cuenta de ticks.
+        last_tick_count = SYSTICK_CCR - SYSTICK_PERIOD_NOW;
+        timer_count = SYSTICK_TAR;
+    } while (ticks != os_time_get());
+
+    return (ticks * SYSTICK_PERIOD) + SYSTICK_COUNTS_TO_TIMESTAMP((uint16_t) (timer_count - last_tick_count));
+}
+
+uint32_t os_timestamp_elapsed_us(os_timestamp_t start)
+{
+    return OS_TIMESTAMP_TO_US(os_timestamp_get() - start);
+}
@@ -0,0 +1,71 @@
+/*
+ * systime.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Fernando Mendoza V.
+ */
+
+#ifndef OS_SYSTIME_H_
+#define OS_SYSTIME_H_
+
+#include <stdint.h>
+
+#include "os.h"
+
+/*
+ * Tiempo del sistema en ticks desde os_init. Es monotónico y de 32 bits: con ticks de 1 ms regresa a 0 después de
+ * 49.7 días. Para comparar dos tiempos usar OS_TIME_BEFORE/OS_TIME_AFTER, que siguen siendo correctas cuando la cuenta
+ * regresa a 0, siempre que la diferencia entre los dos tiempos sea menor que 2^31 ticks.
+ */
+typedef uint32_t os_time_t;
+
+/*
+ * Timestamp de alta resolución, en cuentas del timer de systick (SYSTICK_CLOCK_HZ): el número de ticks por
+ * SYSTICK_PERIOD más las cuentas desde el último tick. Con un clock de 8 MHz regresa a 0 cada 536 segundos, entonces
+ * solo sirve para medir intervalos cortos: la diferencia sin signo entre dos timestamps es correcta aunque la cuenta
+ * regrese a 0 entre ellos.
+ * Con OS_DVFS, las cuentas siguen siendo de SYSTICK_CLOCK_HZ aunque cambie la frecuencia del DCO (ver dvfs.h).
+ */
+typedef uint32_t os_timestamp_t;
+
+#define OS_TIMESTAMP_COUNTS_PER_US      ((uint16_t) (SYSTICK_CLOCK_HZ / 1000000uL))
+
+/* Conversión entre cuentas del timer (o diferencias de timestamps) y microsegundos. */
+#define OS_TIMESTAMP_TO_US(counts)      ((uint32_t) (counts) / OS_TIMESTAMP_COUNTS_PER_US)
+#define OS_US_TO_TIMESTAMP(us)          ((os_timestamp_t) (us) * OS_TIMESTAMP_COUNTS_PER_US)
+
+#define OS_TIME_BEFORE(a, b)    ((int32_t) ((os_time_t) (a) - (os_time_t) (b)) < 0)
+#define OS_TIME_AFTER(a, b)     OS_TIME_BEFORE((b), (a))
+
+/**
+ * @brief Obtiene el número de ticks desde os_init.
+ *
+ * La lectura es consistente aunque systick_isr incremente la cuenta durante la lectura, y no desactiva interrupciones.
+ * Se puede usar desde tareas y desde ISRs.
+ *
+ * @return El tiempo actual del sistema, en ticks.
+ */
+os_time_t os_time_get(void);
+
+/**
+ * @brief Obtiene un timestamp de alta resolución, con la resolución del timer de systick.
+ *
+ * Combina el número de ticks con el contador del timer. Si systick_isr se ejecuta durante la lectura, la lectura se
+ * repite. Si la interrupción de systick está pendiente (por ejemplo, dentro de una sección crítica), las cuentas se
+ * siguen midiendo desde el último tick procesado, así que el timestamp sigue siendo monotónico mientras el tick no se
+ * retrase más de 65535 cuentas. Se puede usar desde tareas y desde ISRs.
+ *
+ * @return El timestamp actual, en cuentas del timer de systick.
+ */
+os_timestamp_t os_timestamp_get(void);
+
+/**
+ * @brief Calcula los microsegundos transcurridos desde un timestamp.
+ *
+ * @param start Timestamp obtenido con os_timestamp_get.
+ *
+ * @return Microsegundos desde start.
+ */
+uint32_t os_timestamp_elapsed_us(os_timestamp_t start);
+
+#endif /* OS_SYSTIME_H_ */
@@ -4,24 +4,97 @@
  *  Created on: Oct 13, 2024
  *      Author: Fernando Mendoza V.
  */
+#include <msp430.h>
+
 #include "tasks.h"
+#include "critical.h"
 
 #include "os_private.h"
 
+#if (OS_TASK_STACK_BYTES <= TASK_STACK_KERNEL_BYTES) || (0u != (OS_TASK_STACK_BYTES % 2u))
+#error "OS_TASK_STACK_BYTES debe ser par y mayor que TASK_STACK_KERNEL_BYTES (os_private.h)"
+#endif
+
 volatile task_t tasks[NUM_TASK_MAX];
 
+volatile uint16_t task_contexts[OS_EXTENDED_TASK_COUNT][TASK_STACK_SIZE];
+
 volatile task_id_t current_task = OS_TASK_ID_MAX;
 volatile uint8_t num_active_tasks = 0u;
 
+#ifndef OS_STATIC_CONFIG
+static uint8_t num_extended_tasks = 0u;
+#endif /* OS_STATIC_CONFIG */
+
+static void task_context_reset(task_id_t task_id);
+
+#ifdef OS_STATIC_CONFIG
+void tasks_init(void)
+{
+    task_id_t i;
+
+    i = NUM_TASK_MAX;
+    while (i--)
+    {
+        tasks[i].state = OS_TASK_STATE_SUSPENDED;
+
+#ifdef OS_SCHEDULER_EDF
+        if (0u != os_task_config[i].period)
+        {
+            tasks[i].ticks_to_release = os_task_config[i].period;
+            tasks[i].ticks_to_deadline = os_task_config[i].deadline;
+        }
+        else
+        {
+            tasks[i].ticks_to_deadline = OS_MAX_TICKS;
+        }
+#endif /* OS_SCHEDULER_EDF */
+
+        if (OS_TASK_CLASS_EXTENDED == os_task_config[i].task_class)
+        {
+            task_context_reset(i);
+        }
+    }
+}
+#else
 error_id_e os_task_create(os_task_id_t task_id, os_task_function_t task_function, uint8_t priority, uint8_t autostart)
+{
+    return task_create(task_id, task_function, priority, autostart, OS_TASK_CLASS_EXTENDED);
+}
+
+error_id_e os_task_create_basic(os_task_id_t task_id, os_task_function_t task_function, uint8_t priority, uint8_t autostart)
+{
+    return task_create(task_id, task_function, priority, autostart, OS_TASK_CLASS_BASIC);
+}
+
+error_id_e task_create(task_id_t task_id, task_function_t task_function, uint8_t priority, uint8_t autostart,
+                       task_class_e task_class)
 {
     error_id_e status = OS_OK;
+    uint8_t context_id = 0u;
 
-    if (NUM_TASK_MAX < task_id)
+    if (NUM_TASK_MAX <= task_id)
     {
         status = OS_ERROR_INVALID_ARGUMENT;
     }
 
+    if (OS_OK == status && OS_TASK_CLASS_EXTENDED == task_class)
+    {
+        if (OS_TASK_STATE_EMPTY != tasks[task_id].state && OS_TASK_CLASS_EXTENDED == tasks[task_id].task_class)
+        {
+            // La tarea ya existía como tarea extendida, reutilizar su contexto y stack.
+            context_id = tasks[task_id].context_id;
+        }
+        else if (OS_EXTENDED_TASK_COUNT <= num_extended_tasks)
+        {
+            status = OS_ERROR_MAX_CREATED_TASKS;
+        }
+        else
+        {
+            context_id = num_extended_tasks++;
+        }
+    }
+
     if (OS_OK == status)
     {
         tasks[(task_id_t) task_id] = (task_t) {
@@ -29,11 +102,107 @@ error_id_e os_task_create(os_task_id_t task_id, os_task_function_t task_function
             .task_function = (task_function_t) task_function,
             .priority = priority,
             .autostart = autostart,
+            .task_class = task_class,
+            .context_id = context_id,
+#ifdef OS_SCHEDULER_EDF
+            .ticks_to_deadline = OS_MAX_TICKS,
+#endif /* OS_SCHEDULER_EDF */
         };
+
+        if (OS_TASK_CLASS_EXTENDED == task_class)
+        {
+            task_context_reset((task_id_t) task_id);
+        }
     }
 
     return status;
 }
+#endif /* OS_STATIC_CONFIG */
+
+static void task_context_reset(task_id_t task_id)
+{
+    // Contexto inicial: SP al inicio del stack de la tarea, PC a la dirección de inicio de la tarea, interrupciones
+    // activadas.
+    TASK_CONTEXT(task_id)[TASK_CONTEXT_SR] = GIE;
+    TASK_CONTEXT(task_id)[TASK_CONTEXT_SP] = TASK_STACK_TOP(TASK_CONFIG(task_id).context_id);
+    TASK_CONTEXT(task_id)[TASK_CONTEXT_PC] = (uint16_t) (uintptr_t) TASK_CONFIG(task_id).task_function;
+}
+
+#ifdef OS_SCHEDULER_EDF
+#ifndef OS_STATIC_CONFIG
+error_id_e os_task_create_periodic(os_task_id_t task_id, os_task_function_t task_function, uint8_t priority,
+                                   tick_type_t period, tick_type_t deadline, uint8_t autostart)
+{
+    error_id_e status = OS_OK;
+
+    if (0u == period || 0u == deadline || period < deadline || OS_MAX_TICKS == deadline)
+    {
+        status = OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (OS_OK == status)
+    {
+        status = os_task_create(task_id, task_function, priority, autostart);
+    }
+
+    if (OS_OK == status)
+    {
+        tasks[(task_id_t) task_id].period = period;
+        tasks[(task_id_t) task_id].deadline = deadline;
+        tasks[(task_id_t) task_id].ticks_to_release = period;
+        tasks[(task_id_t) task_id].ticks_to_deadline = deadline;
+    }
+
+    return status;
+}
+#endif /* OS_STATIC_CONFIG */
+
+error_id_e os_task_get_deadline_misses(os_task_id_t task_id, uint8_t * misses)
+{
+    if (NUM_TASK_MAX <= task_id || 0 == misses)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    *misses = tasks[task_id].deadline_misses;
+
+    return OS_OK;
+}
+#endif /* OS_SCHEDULER_EDF */
+
+#ifdef OS_PREEMPTION_THRESHOLD
+#ifndef OS_STATIC_CONFIG
+error_id_e os_task_set_threshold(os_task_id_t task_id, uint8_t threshold)
+{
+    if (NUM_TASK_MAX <= task_id || OS_TASK_STATE_EMPTY == tasks[task_id].state ||
+        tasks[task_id].priority > threshold)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    tasks[task_id].threshold = threshold;
+
+    return OS_OK;
+}
+#endif /* OS_STATIC_CONFIG */
+#endif /* OS_PREEMPTION_THRESHOLD */
+
+#ifdef OS_SUPERVISOR
+#ifndef OS_STATIC_CONFIG
+error_id_e os_task_set_watchdog(os_task_id_t task_id, tick_type_t watchdog_ticks)
+{
+    if (NUM_TASK_MAX <= task_id || OS_TASK_STATE_EMPTY == tasks[task_id].state)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
+
+    tasks[task_id].checkin_ticks = 0u;
+    tasks[task_id].watchdog_ticks = watchdog_ticks;
+
+    return OS_OK;
+}
+#endif /* OS_STATIC_CONFIG */
+#endif /* OS_SUPERVISOR */
 
 error_id_e os_task_activate(os_task_id_t task_id)
 {
@@ -44,9 +213,13 @@ error_id_e os_task_activate(os_task_id_t task_id)
         status = OS_ERROR_INVALID_ARGUMENT;
     }
 
-    if (NUM_TASK_MAX == num_active_tasks)
+    // Una alarma o una ISR que activa tareas entre la revisión del estado y el conteo de activaciones perdería una
+    // activación y contaría dos veces la tarea en num_active_tasks.
+    os_enter_critical();
+
+    if (OS_OK == status)
     {
-        status = OS_ERROR_MAX_ACTIVE_TASKS;
+        status = task_activate((task_id_t) task_id);
     }
 
     if (OS_OK == status)
@@ -54,63 +227,124 @@ error_id_e os_task_activate(os_task_id_t task_id)
         if (OS_TASK_ID_MAX != current_task)
         {
             tasks[current_task].state = OS_TASK_STATE_READY;
+#ifdef OS_PREEMPTION_THRESHOLD
+            tasks[current_task].preempted = 1u;
+#endif /* OS_PREEMPTION_THRESHOLD */
         }
 
-        tasks[task_id].state = OS_TASK_STATE_READY;
-        num_active_tasks++;
-
         scheduler_run();
     }
+
+    os_exit_critical();
+
     return status;
 }
 
-error_id_e os_task_activate_from_isr(os_task_id_t task_id)
+error_id_e task_activate(task_id_t task_id)
 {
-    if (NUM_TASK_MAX <= task_id || OS_TASK_STATE_SUSPENDED != tasks[task_id].state)
+    if (NUM_TASK_MAX <= task_id || OS_TASK_STATE_EMPTY == tasks[task_id].state)
     {
         return OS_ERROR_INVALID_ARGUMENT;
     }
 
-    if (NUM_TASK_MAX == num_active_tasks)
+    if (OS_TASK_STATE_SUSPENDED == tasks[task_id].state)
     {
-        return OS_ERROR_MAX_ACTIVE_TASKS;
+        tasks[task_id].state = OS_TASK_STATE_READY;
+        tasks[task_id].activations = 1u;
+        num_active_tasks++;
     }
-
-    if (OS_TASK_ID_MAX != current_task)
+    else if (OS_TASK_ACTIVATIONS_MAX > tasks[task_id].activations)
+    {
+        // La tarea ya está activa. Registrar la activación para que la tarea vuelva a ejecutarse cuando termine.
+        tasks[task_id].activations++;
+    }
+    else
     {
-        tasks[current_task].state = OS_TASK_STATE_READY;
+#ifdef OS_ACTIVATION_OVERFLOW_HOOK
+        os_activation_overflow_hook((os_task_id_t) task_id);
+#endif /* OS_ACTIVATION_OVERFLOW_HOOK */
+        return OS_ERROR_MAX_ACTIVATIONS;
     }
 
-    tasks[task_id].state = OS_TASK_STATE_READY;
-    num_active_tasks++;
+    return OS_OK;
+}
 
-    __asm volatile (" ADD #2, SP");
-    // Recuperar valores originales de R11 -> R15 desde el stack (la ISR los mueve cuando inicia).
-    __asm volatile (" POP R11");
-    __asm volatile (" POP R12");
-    __asm volatile (" POP R13");
-    __asm volatile (" POP R14");
-    __asm volatile (" POP R15");
-    __asm volatile (" POP R2");
+error_id_e os_task_activate_from_isr(os_task_id_t task_id)
+{
+    error_id_e status;
 
-    scheduler_run();
+    if (NUM_TASK_MAX <= task_id)
+    {
+        return OS_ERROR_INVALID_ARGUMENT;
+    }
 
-    return OS_OK;
+    status = task_activate((task_id_t) task_id);
+
+    if (OS_OK == status)
+    {
+        // El cambio de contexto ocurre en os_isr_exit, cuando la ISR termina.
+        os_switch_pending = 1u;
+    }
+
+    return status;
 }
 
 error_id_e os_task_terminate(void)
 {
-    tasks[current_task].state = OS_TASK_STATE_SUSPENDED;
-    tasks[current_task].stack[TASK_STACK_SIZE - 2u] = 0u;
-    tasks[current_task].stack[TASK_STACK_SIZE - 1u] = (uint16_t) tasks[current_task].task_function;
+    // Una ISR que cambia de tarea entre task_end y scheduler_run guardaría el contexto de la tarea a la mitad de
+    // os_task_terminate sobre su contexto inicial.
+    os_enter_critical();
+
+    task_end(current_task);
+
+    if (TASK_IS_STACKLESS(current_task))
+    {
+        // Una tarea básica o corrutina termina cuando retorna al scheduler, que la despachó como una llamada anidada.
+        os_exit_critical();
+        return OS_OK;
+    }
+
+    task_context_reset(current_task);
 
-    num_active_tasks--;
+    // El contexto de la tarea que termina no debe guardarse, porque sobreescribiría el contexto inicial. Esto también
+    // hace que el scheduler cargue el contexto inicial si vuelve a elegir a la misma tarea.
+    current_task = OS_TASK_ID_MAX;
 
+    // El scheduler carga otro contexto con su propio estado de interrupciones, entonces solo retorna si no hay tareas
+    // listas.
     scheduler_run();
 
+    os_exit_critical();
+
     return OS_OK;
 }
 
+void task_end(task_id_t task_id)
+{
+#ifdef OS_SUPERVISOR
+    // Terminar cuenta como reporte al supervisor. La siguiente activación comienza un intervalo nuevo.
+    tasks[task_id].checkin_ticks = 0u;
+#endif /* OS_SUPERVISOR */
+
+    if (1u < tasks[task_id].activations)
+    {
+        // Hay activaciones pendientes. La tarea vuelve a ejecutarse desde el inicio.
+        tasks[task_id].activations--;
+        tasks[task_id].state = OS_TASK_STATE_READY;
+    }
+    else
+    {
+        tasks[task_id].activations = 0u;
+        tasks[task_id].state = OS_TASK_STATE_SUSPENDED;
+        num_active_tasks--;
+    }
+}
+
+uint8_t task_can_wait(void)
+{
+    return (OS_TASK_ID_MAX != current_task && OS_TASK_CLASS_EXTENDED == TASK_CONFIG(current_task).task_class);
+}
+
 error_id_e os_task_chain(os_task_id_t task_id)
 {
     volatile error_id_e status = OS_OK;
@@ -122,11 +356,25 @@ error_id_e os_task_chain(os_task_id_t task_id)
 
     if (OS_OK == status)
     {
-        tasks[current_task].state = OS_TASK_STATE_SUSPENDED;
+        // Igual que en os_task_activate, una ISR también modifica activations.
+        os_enter_critical();
 
-        tasks[task_id].state = OS_TASK_STATE_READY;
+        if (current_task == task_id)
+        {
+            // Encadenar la tarea actual consigo misma la reinicia, sin consumir una activación adicional.
+            tasks[current_task].activations++;
+        }
+        else
+        {
+            status = task_activate((task_id_t) task_id);
+        }
 
-        scheduler_run();
+        os_exit_critical();
+    }
+
+    if (OS_OK == status)
+    {
+        os_task_terminate();
     }
 
     return status;
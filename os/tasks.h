@@ -14,58 +14,189 @@
 typedef uint8_t os_task_id_t;
 typedef void (*os_task_function_t)(void);
 
+/*
+ * Con OS_STATIC_CONFIG las tareas se definen en app.oil y no hay servicios para crearlas durante la ejecución.
+ */
+#ifndef OS_STATIC_CONFIG
 /**
- * @brief Registra los atributos de una nueva tarea.
+ * @brief Registra los atributos de una nueva tarea extendida.
+ *
+ * Una tarea extendida tiene stack y contexto propios, entonces puede esperar (por ejemplo, en os_queue_receive).
  *
- * @param task_id Identificador nico de la tarea.
- * @param task_function Direccin de inicio de la tarea.
+ * @param task_id Identificador único de la tarea.
+ * @param task_function Dirección de inicio de la tarea.
  * @param priority Prioridad de la tarea (0-255).
- * @param autostart Si es TRUE, inicializar el OS activa automticamente la tarea.
+ * @param autostart Si es TRUE, inicializar el OS activa automáticamente la tarea.
  *
- * @return OS_OK si registr la tarea.
- *         OS_ERROR_INVALID_ARGUMENT si el valor de task_id no es un identificador vlido.
- *         OS_ERROR_MAX_CREATED_TASKS si el OS alcanz el lmite de tareas creadas.
+ * @return OS_OK si registró la tarea.
+ *         OS_ERROR_INVALID_ARGUMENT si el valor de task_id no es un identificador válido.
+ *         OS_ERROR_MAX_CREATED_TASKS si el OS alcanzó el límite de tareas extendidas (OS_EXTENDED_TASK_COUNT).
  */
 error_id_e os_task_create(os_task_id_t task_id, os_task_function_t task_function, uint8_t priority, uint8_t autostart);
 
+/**
+ * @brief Registra los atributos de una nueva tarea básica.
+ *
+ * Una tarea básica se ejecuta hasta terminar sin esperar, y no necesita stack ni contexto propios: el scheduler la
+ * ejecuta como una llamada anidada sobre el stack del contexto que la desplaza. Mientras hay una tarea básica en
+ * ejecución, solo otra tarea básica de mayor prioridad puede desplazarla.
+ *
+ * Los servicios que esperan (por ejemplo, os_queue_receive con ticks_to_wait distinto de 0) regresan
+ * OS_ERROR_TASK_CLASS en una tarea básica. os_task_terminate sí regresa en una tarea básica, entonces debe ser la
+ * última instrucción de la tarea.
+ *
+ * @param task_id Identificador único de la tarea.
+ * @param task_function Dirección de inicio de la tarea.
+ * @param priority Prioridad de la tarea (0-255).
+ * @param autostart Si es TRUE, inicializar el OS activa automáticamente la tarea.
+ *
+ * @return OS_OK si registró la tarea.
+ *         OS_ERROR_INVALID_ARGUMENT si el valor de task_id no es un identificador válido.
+ */
+error_id_e os_task_create_basic(os_task_id_t task_id, os_task_function_t task_function, uint8_t priority, uint8_t autostart);
+#endif /* OS_STATIC_CONFIG */
+
+#ifdef OS_SCHEDULER_EDF
+#ifndef OS_STATIC_CONFIG
+/**
+ * @brief Registra los atributos de una nueva tarea periódica, planificada por EDF.
+ *
+ * El OS activa la tarea al inicio de cada periodo. Si la tarea no termina (os_task_terminate) antes de su deadline,
+ * el OS registra un deadline perdido.
+ *
+ * @param task_id Identificador único de la tarea.
+ * @param task_function Dirección de inicio de la tarea.
+ * @param priority Prioridad de la tarea (0-255). Solo desempata tareas con el mismo deadline absoluto.
+ * @param period Periodo de activación de la tarea, en ticks.
+ * @param deadline Deadline relativo al inicio de cada periodo, en ticks. Debe ser menor o igual que period.
+ * @param autostart Si es TRUE, inicializar el OS inicia el primer periodo con la tarea activa. Si es FALSE,
+ *        la primera activación ocurre al terminar el primer periodo.
+ *
+ * @return OS_OK si registró la tarea.
+ *         OS_ERROR_INVALID_ARGUMENT si task_id, period o deadline tienen valores inválidos.
+ */
+error_id_e os_task_create_periodic(os_task_id_t task_id, os_task_function_t task_function, uint8_t priority,
+                                   tick_type_t period, tick_type_t deadline, uint8_t autostart);
+#endif /* OS_STATIC_CONFIG */
+
+/**
+ * @brief Obtiene el número de deadlines que ha perdido una tarea periódica.
+ *
+ * @param task_id Identificador único de la tarea.
+ * @param misses Espacio para recibir el número de deadlines perdidos (satura en 255).
+ *
+ * @return OS_OK si obtuvo el número de deadlines perdidos.
+ *         OS_ERROR_INVALID_ARGUMENT si task_id no es un identificador válido o misses es nulo.
+ */
+error_id_e os_task_get_deadline_misses(os_task_id_t task_id, uint8_t * misses);
+#endif /* OS_SCHEDULER_EDF */
+
+#ifdef OS_PREEMPTION_THRESHOLD
+#ifndef OS_STATIC_CONFIG
+/**
+ * @brief Asigna el umbral de desplazamiento de una tarea creada.
+ *
+ * Desde que la tarea comienza a ejecutarse hasta que termina o espera, solo la desplazan tareas con prioridad mayor
+ * que threshold. Para que un grupo de tareas no se desplacen entre sí, asignar a todas el umbral igual a la prioridad
+ * más alta del grupo. Con threshold igual a la prioridad de la tarea, la tarea no tiene umbral.
+ *
+ * @param task_id Identificador único de la tarea.
+ * @param threshold Umbral de desplazamiento (0-255). Debe ser mayor o igual que la prioridad de la tarea.
+ *
+ * @return OS_OK si asignó el umbral.
+ *         OS_ERROR_INVALID_ARGUMENT si task_id no es válido, la tarea no fue creada o threshold es menor que su
+ *         prioridad.
+ */
+error_id_e os_task_set_threshold(os_task_id_t task_id, uint8_t threshold);
+#endif /* OS_STATIC_CONFIG */
+#endif /* OS_PREEMPTION_THRESHOLD */
+
+#ifdef OS_SUPERVISOR
+#ifndef OS_STATIC_CONFIG
+/**
+ * @brief Asigna el intervalo máximo de una tarea creada entre su activación o su último reporte al supervisor
+ * (os_supervisor_checkin) y su siguiente reporte o su terminación. Ver supervisor.h.
+ *
+ * @param task_id Identificador único de la tarea.
+ * @param watchdog_ticks Intervalo máximo en ticks. 0 para que el supervisor no revise la tarea.
+ *
+ * @return OS_OK si asignó el intervalo.
+ *         OS_ERROR_INVALID_ARGUMENT si task_id no es válido o la tarea no fue creada.
+ */
+error_id_e os_task_set_watchdog(os_task_id_t task_id, tick_type_t watchdog_ticks);
+#endif /* OS_STATIC_CONFIG */
+#endif /* OS_SUPERVISOR */
+
+#ifdef OS_ACTIVATION_OVERFLOW_HOOK
+/**
+ * @brief Hook que el OS llama cuando una activación se pierde porque la tarea ya tiene OS_TASK_ACTIVATIONS_MAX
+ * activaciones registradas. La aplicación debe definir esta función.
+ *
+ * Puede ejecutarse desde systick_isr (alarmas), entonces debe ser breve y no puede usar servicios que esperen.
+ *
+ * @param task_id Identificador único de la tarea que no pudo activarse.
+ */
+void os_activation_overflow_hook(os_task_id_t task_id);
+#endif /* OS_ACTIVATION_OVERFLOW_HOOK */
+
+#ifdef OS_DEADLINE_MISS_HOOK
+/**
+ * @brief Hook que el OS llama cuando una tarea periódica pierde su deadline. La aplicación debe definir esta función.
+ *
+ * Se ejecuta desde systick_isr, entonces debe ser breve y no puede usar servicios que esperen.
+ *
+ * @param task_id Identificador único de la tarea que perdió su deadline.
+ */
+void os_deadline_miss_hook(os_task_id_t task_id);
+#endif /* OS_DEADLINE_MISS_HOOK */
+
 /**
  * @brief Activa una tarea para que pueda ser elegida por el scheduler.
  *
- * @param task_id Identificador nico de la tarea que ser activada.
+ * @param task_id Identificador único de la tarea que será activada.
  *
- * @return OS_OK si activ la tarea.
- *         OS_ERROR_INVALID_ARGUMENT si el valor de task_id no es un identificador vlido.
- *         OS_ERROR_MAX_ACTIVE_TASKS si se alcanz el lmite de tareas activas.
+ * Si la tarea ya está activa, el OS registra la activación y la tarea vuelve a ejecutarse cuando termina, hasta un
+ * máximo de OS_TASK_ACTIVATIONS_MAX activaciones.
+ *
+ * @return OS_OK si activó la tarea o registró la activación.
+ *         OS_ERROR_INVALID_ARGUMENT si el valor de task_id no es un identificador válido.
+ *         OS_ERROR_MAX_ACTIVATIONS si la tarea ya tiene el máximo de activaciones registradas.
  */
 error_id_e os_task_activate(os_task_id_t task_id);
 
 /**
- * @brief Activa una tarea desde una ISR y guarda el contexto de la tarea anterior.
+ * @brief Activa una tarea desde una ISR.
+ *
+ * Si la tarea activada tiene precedencia sobre la tarea interrumpida, el cambio de contexto ocurre cuando la ISR
+ * termina. La ISR debe estar declarada con OS_ISR en os/port.asm, que regresa a través de os_isr_exit.
  *
- * @param task_id Identificador nico de la tarea que ser activada.
+ * @param task_id Identificador único de la tarea que será activada.
  *
- * @return OS_OK si activ la tarea.
- *         OS_ERROR_INVALID_ARGUMENT si el valor de task_id no es un identificador vlido o si ya existe una tarea con ese ID.
- *         OS_ERROR_MAX_ACTIVE_TASKS si se alcanz el lmite de tareas activas.
+ * @return OS_OK si activó la tarea o registró la activación.
+ *         OS_ERROR_INVALID_ARGUMENT si el valor de task_id no es un identificador válido.
+ *         OS_ERROR_MAX_ACTIVATIONS si la tarea ya tiene el máximo de activaciones registradas.
  */
 error_id_e os_task_activate_from_isr(os_task_id_t task_id);
 
 /**
  * @brief Suspende una tarea.
  *
- * La tarea no vuelve a ser ejecutada hasta que se active otra vez.
+ * La tarea no vuelve a ser ejecutada hasta que se active otra vez. Si la tarea tiene activaciones registradas,
+ * consume una y vuelve a ejecutarse desde el inicio.
  *
- * @return OS_OK si suspendi la tarea.
+ * @return OS_OK si suspendió la tarea.
  */
 error_id_e os_task_terminate(void);
 
 /**
  * @brief Suspende la tarea actual y activa otra.
  *
- * @param task_id Identificador nico de la tarea que ser activada.
+ * @param task_id Identificador único de la tarea que será activada.
  *
- * @return OS_OK si suspendi la tarea actual y activ la otra tarea.
- *         OS_ERROR_INVALID_ARGUMENT si el valor de task_id no es un identificador vlido.
+ * @return No regresa si suspendió la tarea actual y activó la otra tarea.
+ *         OS_ERROR_INVALID_ARGUMENT si el valor de task_id no es un identificador válido.
+ *         OS_ERROR_MAX_ACTIVATIONS si la otra tarea ya tiene el máximo de activaciones registradas. La tarea actual
+ *         continúa su ejecución.
  */
 error_id_e os_task_chain(os_task_id_t task_id);
 
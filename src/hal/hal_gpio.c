@@ -122,3 +122,76 @@ void hal_gpio_toggle(gpio_port_t port, uint8_t mask)
         P2OUT ^= mask;
     }
 }
+
+uint8_t hal_gpio_read(gpio_port_t port, uint8_t mask)
+{
+    uint8_t value = 0u;
+
+    if (GPIO_PORT_1 == port)
+    {
+        value = P1IN & mask;
+    }
+    else if (GPIO_PORT_2 == port)
+    {
+        value = P2IN & mask;
+    }
+
+    return value;
+}
+
+void hal_gpio_irq_enable(gpio_port_t port, uint8_t mask, uint8_t falling_mask)
+{
+    // Cambiar P1IES puede activar P1IFG, entonces se borra la bandera antes de activar la interrupción.
+    if (GPIO_PORT_1 == port)
+    {
+        P1IES = (P1IES & ~mask) | (falling_mask & mask);
+        P1IFG &= ~mask;
+        P1IE |= mask;
+    }
+    else if (GPIO_PORT_2 == port)
+    {
+        P2IES = (P2IES & ~mask) | (falling_mask & mask);
+        P2IFG &= ~mask;
+        P2IE |= mask;
+    }
+}
+
+void hal_gpio_irq_disable(gpio_port_t port, uint8_t mask)
+{
+    if (GPIO_PORT_1 == port)
+    {
+        P1IE &= ~mask;
+    }
+    else if (GPIO_PORT_2 == port)
+    {
+        P2IE &= ~mask;
+    }
+}
+
+uint8_t hal_gpio_irq_pending(gpio_port_t port)
+{
+    uint8_t pending = 0u;
+
+    if (GPIO_PORT_1 == port)
+    {
+        pending = P1IFG & P1IE;
+    }
+    else if (GPIO_PORT_2 == port)
+    {
+        pending = P2IFG & P2IE;
+    }
+
+    return pending;
+}
+
+void hal_gpio_irq_clear(gpio_port_t port, uint8_t mask)
+{
+    if (GPIO_PORT_1 == port)
+    {
+        P1IFG &= ~mask;
+    }
+    else if (GPIO_PORT_2 == port)
+    {
+        P2IFG &= ~mask;
+    }
+}
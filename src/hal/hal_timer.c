@@ -6,15 +6,23 @@
  */
 #include "hal_timer.h"
 
+// Cuentas de SMCLK por milisegundo.
+static volatile uint16_t timer_counts_per_ms = (uint16_t) (HAL_TIMER_CLOCK_HZ / 1000uL);
+
 void hal_timer_delay(uint16_t milliseconds)
 {
     uint16_t count = milliseconds;
 
     while (0u != count)
     {
-        TA0CCR1 = TA0R + 8000u;
+        TA0CCR1 = TA0R + timer_counts_per_ms;
         TA0CCTL1 &= ~CCIFG;
         while (0u == (TA0CCTL1 & CCIFG));
         count--;
     }
 }
+
+void hal_timer_set_clock(uint32_t clock_hz)
+{
+    timer_counts_per_ms = (uint16_t) (clock_hz / 1000uL);
+}
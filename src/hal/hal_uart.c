@@ -6,9 +6,24 @@
  */
 #include "hal_uart.h"
 
+#include "em.h"
+
+#define TRANSMIT_INDEX_MASK     ((uint8_t) (UART_SEND_MAX_LEN - 1u))
+
+// Buffer circular de transmisión. Varias tareas pueden llamar a hal_uart_send, entonces solo hal_uart_send modifica
+// transmit_head, con interrupciones desactivadas, y solo usciab_tx_isr modifica transmit_tail. Los índices avanzan sin
+// límite y se reducen con TRANSMIT_INDEX_MASK; head - tail es el número de bytes pendientes.
 static volatile uint8_t transmit_buffer[UART_SEND_MAX_LEN];
-static volatile uint8_t transmit_cursor;
-static volatile uint8_t transmit_end;
+static volatile uint8_t transmit_head;
+static volatile uint8_t transmit_tail;
+
+// Solo se modifica con UCSWRST activo.
+static void uart_set_divider(uint32_t clock_hz)
+{
+    UCA0BR0 = (uint8_t) (UART_BITRATE_DIVIDER(clock_hz) & 0xFFu);
+    UCA0BR1 = (uint8_t) (UART_BITRATE_DIVIDER(clock_hz) >> 8u);
+    UCA0MCTL = (uint8_t) (UART_BITRATE_MODULATION(clock_hz) << 1u);
+}
 
 void hal_uart_init(void)
 {
@@ -16,79 +31,88 @@ void hal_uart_init(void)
 
     UCA0CTL1 |= UCSSEL_2;
 
-    UCA0BR0 = (uint8_t) (UART_BITRATE_DIVIDER & 0xFFu);
-    UCA0BR1 = (uint8_t) (UART_BITRATE_DIVIDER >> 8u);
+    uart_set_divider(UART_CLOCK_HZ);
 
     hal_gpio_init(UART_PORT, UART_PIN_TX, PIN_ALT_3);
 
-    transmit_cursor = UART_SEND_MAX_LEN - 1u;
-    transmit_end = 0u;
+    transmit_head = 0u;
+    transmit_tail = 0u;
 
     UCA0CTL1 &= ~UCSWRST;
 }
 
 uint8_t hal_uart_send(const uint8_t * const buf, uint8_t len)
 {
-    uint8_t i;
+    uint16_t interrupt_state = __get_SR_register() & GIE;
+    uint8_t sent = 0u;
+
+    if (0 == buf)
+    {
+        return 0u;
+    }
+
+    // Los bytes de cada llamada quedan juntos en el buffer aunque otra tarea desplace a esta.
+    EM_GLOBAL_INTERRUPT_DIS;
 
-    i = 0u;
-    if (UART_SEND_MAX_LEN > len && 0u != buf)
+    while (sent < len && UART_SEND_MAX_LEN > (uint8_t) (transmit_head - transmit_tail))
     {
-        while (i < len && transmit_end != transmit_cursor)
-        {
-            transmit_buffer[transmit_end] = buf[i++];
-
-            transmit_end++;
-            if (UART_SEND_MAX_LEN <= transmit_end)
-            {
-                transmit_end = 0u;
-            }
-        }
+        transmit_buffer[transmit_head & TRANSMIT_INDEX_MASK] = buf[sent++];
+        transmit_head++;
     }
 
-    if (0u != i)
+    if (0u != sent)
     {
+        // Con UCA0TXBUF vacío, UCA0TXIFG sigue activo y la ISR se ejecuta en cuanto se activa UCA0TXIE.
         IE2 |= UCA0TXIE;
     }
 
-    return i;
-}
+    if (interrupt_state)
+    {
+        EM_GLOBAL_INTERRUPT_EN;
+    }
 
-//    if (0u == transmit_len_bytes && 0u != buf)
-//    {
-//        while ('\0' != buf[transmit_len_bytes] && UART_SEND_MAX_LEN > transmit_len_bytes)
-//        {
-//            transmit_buffer[transmit_len_bytes] = buf[transmit_len_bytes];
-//            transmit_len_bytes++;
-//        }
-//
-//        bytes_transmitted = 0u;
-//        IE2 |= UCA0TXIE;
-//    }
+    return sent;
+}
 
-#pragma vector=USCIAB0TX_VECTOR
-__interrupt void usciab_tx_isr(void)
+uint8_t hal_uart_set_clock(uint32_t clock_hz)
 {
-    uint8_t i;
+    uint8_t interrupts;
 
-    transmit_cursor++;
-    if (UART_SEND_MAX_LEN <= transmit_cursor)
+    if (UCA0STAT & UCBUSY)
     {
-        transmit_cursor = 0u;
+        return 0u;
     }
 
-    UCA0TXBUF = transmit_buffer[transmit_cursor];
-
-    i = transmit_cursor + 1u;
-    if (UART_SEND_MAX_LEN <= transmit_cursor)
+    if (UCA0CTL1 & UCSWRST)
     {
-        i = 0u;
+        // La UART no se ha iniciado.
+        uart_set_divider(clock_hz);
+        return 1u;
     }
 
-    if (transmit_end == i)
+    // UCSWRST desactiva UCA0TXIE y UCA0RXIE. Con UCA0TXIE de nuevo activo, la ISR continúa con el siguiente byte.
+    interrupts = IE2 & (UCA0TXIE | UCA0RXIE);
+
+    UCA0CTL1 |= UCSWRST;
+    uart_set_divider(clock_hz);
+    UCA0CTL1 &= ~UCSWRST;
+
+    IE2 |= interrupts;
+
+    return 1u;
+}
+
+#pragma vector=USCIAB0TX_VECTOR
+__interrupt void usciab_tx_isr(void)
+{
+    if (transmit_tail != transmit_head)
+    {
+        UCA0TXBUF = transmit_buffer[transmit_tail & TRANSMIT_INDEX_MASK];
+        transmit_tail++;
+    }
+    else
     {
-        transmit_cursor = UART_SEND_MAX_LEN - 1u;
-        transmit_end = 0u;
+        // No hay más bytes. UCA0TXIFG queda activo para la siguiente llamada a hal_uart_send.
         IE2 &= ~UCA0TXIE;
     }
 }
@@ -31,4 +31,16 @@
     DCOCTL = CALDCO_8MHZ;\
 })
 
+#define DCO_CAL_12MHZ() ({\
+    DCOCTL = 0;\
+    BCSCTL1 = CALBC1_12MHZ;\
+    DCOCTL = CALDCO_12MHZ;\
+})
+
+#define DCO_CAL_16MHZ() ({\
+    DCOCTL = 0;\
+    BCSCTL1 = CALBC1_16MHZ;\
+    DCOCTL = CALDCO_16MHZ;\
+})
+
 #endif /* EM_H_ */
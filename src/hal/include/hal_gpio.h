@@ -33,4 +33,15 @@ void hal_gpio_set(gpio_port_t port, uint8_t mask);
 void hal_gpio_reset(gpio_port_t port, uint8_t mask);
 void hal_gpio_toggle(gpio_port_t port, uint8_t mask);
 
+uint8_t hal_gpio_read(gpio_port_t port, uint8_t mask);
+
+/*
+ * Interrupciones por flanco. falling_mask indica qué pines de mask interrumpen en flanco de bajada; los demás
+ * interrumpen en flanco de subida.
+ */
+void hal_gpio_irq_enable(gpio_port_t port, uint8_t mask, uint8_t falling_mask);
+void hal_gpio_irq_disable(gpio_port_t port, uint8_t mask);
+uint8_t hal_gpio_irq_pending(gpio_port_t port);
+void hal_gpio_irq_clear(gpio_port_t port, uint8_t mask);
+
 #endif /* SRC_HAL_INCLUDE_HAL_GPIO_H_ */
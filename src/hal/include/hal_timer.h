@@ -28,6 +28,22 @@
     TA0CCTL0 |= CCIE;\
 })
 
+/* Frecuencia de SMCLK al iniciar, en Hz. */
+#define HAL_TIMER_CLOCK_HZ      (8000000uL)
+
+/**
+ * @brief Espera activa de milliseconds ms con TA0CCR1. El tiempo de espera cuenta como carga del CPU.
+ *
+ * @param milliseconds Duración de la espera.
+ */
 void hal_timer_delay(uint16_t milliseconds);
 
+/**
+ * @brief Actualiza la frecuencia de SMCLK que usa hal_timer_delay. Llamar después de cambiar la frecuencia del DCO
+ * (por ejemplo, con OS_DVFS). Un cambio durante una espera afecta solo al milisegundo en curso.
+ *
+ * @param clock_hz Nueva frecuencia de SMCLK en Hz, múltiplo de 1 kHz y máximo 16 MHz.
+ */
+void hal_timer_set_clock(uint32_t clock_hz);
+
 #endif /* SRC_HAL_INCLUDE_HAL_TIMER_H_ */
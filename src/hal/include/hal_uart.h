@@ -16,11 +16,30 @@
 #define UART_PORT               (GPIO_PORT_1)
 #define UART_PIN_TX             (0x04u)
 
+/* Bytes del buffer de transmisión. Debe ser una potencia de 2, máximo 128 (los índices del buffer son de 8 bits). */
 #define UART_SEND_MAX_LEN       ((uint8_t) 64u)
-#define UART_BITRATE_DIVIDER    ((uint16_t) 69u)
+
+#define UART_BAUD_RATE          (115200uL)
+
+/* Frecuencia de SMCLK al llamar a hal_uart_init, en Hz. */
+#define UART_CLOCK_HZ           (8000000uL)
+
+/* Divisor (UCBRx) y modulación (UCBRSx, redondeada a octavos) del baud rate para un SMCLK de clock_hz Hz. */
+#define UART_BITRATE_DIVIDER(clock_hz)      ((uint16_t) ((clock_hz) / UART_BAUD_RATE))
+#define UART_BITRATE_MODULATION(clock_hz)   ((uint8_t) (((((clock_hz) % UART_BAUD_RATE) * 16u / UART_BAUD_RATE) + 1u) / 2u))
 
 void hal_uart_init(void);
 
 uint8_t hal_uart_send(const uint8_t * const buf, uint8_t len);
 
+/**
+ * @brief Recalcula el divisor de la UART después de cambiar la frecuencia de SMCLK, para conservar el baud rate. Se
+ * llama con interrupciones desactivadas.
+ *
+ * @param clock_hz Nueva frecuencia de SMCLK, en Hz.
+ *
+ * @return 1 si cambió el divisor, 0 si la UART está transmitiendo un byte y no lo cambió.
+ */
+uint8_t hal_uart_set_clock(uint32_t clock_hz);
+
 #endif /* SRC_HAL_INCLUDE_HAL_UART_H_ */
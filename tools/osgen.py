@@ -0,0 +1,471 @@
+#!/usr/bin/env python3
+#
+# osgen.py
+#
+#  Created on: Oct 18, 2026
+#      Author: Fernando Mendoza V.
+#
+"""
+Generador de la configuración estática de Nano-RTOS (OS_STATIC_CONFIG).
+
+Lee un archivo de configuración con un subconjunto de la sintaxis de OIL (OSEK Implementation Language) y genera:
+
+- os_gen_cfg.h: número de tareas, tareas extendidas, alarmas y queues, e identificadores (<NOMBRE>_ID) de cada objeto.
+- os_gen_cfg.c: tablas const (en flash) con los atributos de tareas, alarmas y queues.
+
+En RAM solo queda el estado mutable (estado de cada tarea, cuentas de alarmas, contenido de queues). Los errores de
+configuración terminan el generador con código 1; las restricciones que dependen de os_config.h (tamaño de stacks,
+longitud de queues, funciones habilitadas) se revisan con #error al compilar os_gen_cfg.c.
+
+Formato del archivo de entrada ('//' y '/* */' son comentarios):
+
+    CPU <nombre> {
+        TASK <NOMBRE> {
+            ENTRY = <función de la tarea>;
+            PRIORITY = <0-255>;
+            THRESHOLD = <PRIORITY-255>;             // Opcional, umbral de desplazamiento (OS_PREEMPTION_THRESHOLD).
+            CLASS = EXTENDED | BASIC | COROUTINE;   // Opcional, EXTENDED por default.
+            AUTOSTART = TRUE | FALSE;               // Opcional, FALSE por default.
+            STACK = <bytes>;                        // Opcional, solo tareas extendidas, sin contar al kernel.
+            PERIOD = <ticks>;                       // Opcional, tarea periódica (OS_SCHEDULER_EDF).
+            DEADLINE = <ticks>;                     // Opcional, igual al periodo por default.
+            WATCHDOG = <ticks>;                     // Opcional, intervalo del supervisor (OS_SUPERVISOR).
+        };
+        ALARM <NOMBRE> {
+            TASK = <NOMBRE de una tarea>;           // O CALLBACK = <función> (OS_TIMER_SERVICE).
+            AUTOSTART = TRUE | FALSE;               // Opcional, FALSE por default.
+            ALARMTIME = <ticks>;                    // Primera expiración, si la alarma tiene autostart.
+            CYCLETIME = <ticks>;                    // Opcional, 0 (activación única) por default.
+        };
+        QUEUE <NOMBRE> {
+            LENGTH = <elementos>;
+            ACCESS = <NOMBRE de una tarea>;         // Una línea por cada tarea con acceso.
+        };
+    };
+
+Los identificadores se asignan en el orden del archivo. El contexto (y el stack) de cada tarea extendida también.
+
+Uso:
+    python3 tools/osgen.py app.oil [--out os/config]
+"""
+
+import argparse
+import os
+import re
+import sys
+
+MAX_TASKS = 8               # Campos de bits de 8 bits (permisos de queues, tablas de activación).
+MAX_TICKS = 0xFFFF          # tick_type_t es de 16 bits.
+TASK_CLASSES = ("EXTENDED", "BASIC", "COROUTINE")
+
+OBJECT_ATTRIBUTES = {
+    "TASK": {"ENTRY", "PRIORITY", "THRESHOLD", "CLASS", "AUTOSTART", "STACK", "PERIOD", "DEADLINE", "WATCHDOG"},
+    "ALARM": {"TASK", "CALLBACK", "AUTOSTART", "ALARMTIME", "CYCLETIME"},
+    "QUEUE": {"LENGTH", "ACCESS"},
+}
+
+MULTI_VALUED = {("QUEUE", "ACCESS")}
+
+TOKEN_RE = re.compile(r"//[^\n]*|/\*.*?\*/|[A-Za-z_][A-Za-z0-9_]*|0[xX][0-9A-Fa-f]+|[0-9]+|[{};=]|\s+|.", re.DOTALL)
+
+
+class ConfigError(Exception):
+    pass
+
+
+class OilObject:
+    def __init__(self, kind, name, line):
+        self.kind = kind
+        self.name = name
+        self.line = line
+        self.attributes = {}
+
+
+def tokenize(text):
+    tokens = []
+    line = 1
+
+    for match in TOKEN_RE.finditer(text):
+        token = match.group(0)
+        if token.isspace() or token.startswith(("//", "/*")):
+            pass
+        elif 1 == len(token) and token not in "{};=" and not token.isalnum() and "_" != token:
+            raise ConfigError("línea %d: carácter inesperado '%s'" % (line, token))
+        else:
+            tokens.append((token, line))
+        line += token.count("\n")
+
+    return tokens
+
+
+class Parser:
+    def __init__(self, tokens):
+        self.tokens = tokens
+        self.index = 0
+
+    def peek(self):
+        return self.tokens[self.index][0] if self.index < len(self.tokens) else None
+
+    def line(self):
+        if self.index < len(self.tokens):
+            return self.tokens[self.index][1]
+        return self.tokens[-1][1] if self.tokens else 1
+
+    def take(self, expected=None):
+        if self.index >= len(self.tokens):
+            raise ConfigError("fin de archivo inesperado")
+        token = self.tokens[self.index][0]
+        if expected is not None and token != expected:
+            raise ConfigError("línea %d: se esperaba '%s' y se encontró '%s'" % (self.line(), expected, token))
+        self.index += 1
+        return token
+
+    def identifier(self):
+        line = self.line()
+        token = self.take()
+        if not re.match(r"[A-Za-z_]", token):
+            raise ConfigError("línea %d: se esperaba un identificador y se encontró '%s'" % (line, token))
+        return token
+
+    def parse(self):
+        self.take("CPU")
+        self.identifier()
+        self.take("{")
+
+        objects = []
+        while self.peek() != "}":
+            line = self.line()
+            kind = self.identifier()
+            if kind not in OBJECT_ATTRIBUTES:
+                raise ConfigError("línea %d: tipo de objeto desconocido '%s'" % (line, kind))
+            obj = OilObject(kind, self.identifier(), line)
+            self.take("{")
+
+            while self.peek() != "}":
+                line = self.line()
+                attribute = self.identifier()
+                if attribute not in OBJECT_ATTRIBUTES[kind]:
+                    raise ConfigError("línea %d: %s no tiene el atributo '%s'" % (line, kind, attribute))
+                self.take("=")
+                value = self.take()
+                self.take(";")
+
+                if (kind, attribute) in MULTI_VALUED:
+                    obj.attributes.setdefault(attribute, []).append((value, line))
+                elif attribute in obj.attributes:
+                    raise ConfigError("línea %d: atributo '%s' repetido en %s" % (line, attribute, obj.name))
+                else:
+                    obj.attributes[attribute] = (value, line)
+
+            self.take("}")
+            self.take(";")
+            objects.append(obj)
+
+        self.take("}")
+        self.take(";")
+        if self.peek() is not None:
+            raise ConfigError("línea %d: contenido después del bloque CPU" % self.line())
+
+        return objects
+
+
+def integer(obj, attribute, default=None, minimum=0, maximum=MAX_TICKS):
+    if attribute not in obj.attributes:
+        if default is None:
+            raise ConfigError("línea %d: %s %s necesita el atributo %s" % (obj.line, obj.kind, obj.name, attribute))
+        return default
+
+    value, line = obj.attributes[attribute]
+    try:
+        number = int(value, 0)
+    except ValueError:
+        raise ConfigError("línea %d: %s debe ser un número" % (line, attribute))
+    if not minimum <= number <= maximum:
+        raise ConfigError("línea %d: %s debe estar en el rango %d-%d" % (line, attribute, minimum, maximum))
+    return number
+
+
+def boolean(obj, attribute):
+    value, line = obj.attributes.get(attribute, ("FALSE", obj.line))
+    if value not in ("TRUE", "FALSE"):
+        raise ConfigError("línea %d: %s debe ser TRUE o FALSE" % (line, attribute))
+    return "TRUE" == value
+
+
+def build_config(objects):
+    names = {}
+    for obj in objects:
+        if obj.name in names:
+            raise ConfigError("línea %d: el nombre %s ya está definido" % (obj.line, obj.name))
+        names[obj.name] = obj
+
+    tasks = [o for o in objects if "TASK" == o.kind]
+    alarms = [o for o in objects if "ALARM" == o.kind]
+    queues = [o for o in objects if "QUEUE" == o.kind]
+
+    if not tasks:
+        raise ConfigError("la configuración no tiene tareas")
+    if len(tasks) > MAX_TASKS:
+        raise ConfigError("la configuración tiene %d tareas, el máximo es %d" % (len(tasks), MAX_TASKS))
+    if not alarms:
+        raise ConfigError("la configuración necesita al menos una alarma")
+
+    task_ids = {t.name: i for i, t in enumerate(tasks)}
+
+    def task_reference(value, line):
+        if value not in task_ids:
+            raise ConfigError("línea %d: %s no es una tarea" % (line, value))
+        return task_ids[value]
+
+    config = {"tasks": [], "alarms": [], "queues": []}
+    context_id = 0
+
+    for task in tasks:
+        task_class, line = task.attributes.get("CLASS", ("EXTENDED", task.line))
+        if task_class not in TASK_CLASSES:
+            raise ConfigError("línea %d: CLASS debe ser uno de %s" % (line, ", ".join(TASK_CLASSES)))
+        if "STACK" in task.attributes and "EXTENDED" != task_class:
+            raise ConfigError("línea %d: solo las tareas extendidas tienen stack" % task.attributes["STACK"][1])
+
+        entry = task.attributes.get("ENTRY", (None, task.line))[0]
+        if entry is None or not re.match(r"[A-Za-z_]", entry):
+            raise ConfigError("línea %d: TASK %s necesita un ENTRY válido" % (task.line, task.name))
+
+        period = integer(task, "PERIOD", default=0, minimum=1, maximum=MAX_TICKS)
+        deadline = integer(task, "DEADLINE", default=period, minimum=1, maximum=MAX_TICKS - 1) if period else 0
+        if "DEADLINE" in task.attributes and 0 == period:
+            raise ConfigError("línea %d: DEADLINE necesita PERIOD" % task.attributes["DEADLINE"][1])
+        if deadline > period:
+            raise ConfigError("línea %d: DEADLINE de %s es mayor que su PERIOD" % (task.line, task.name))
+
+        priority = integer(task, "PRIORITY", minimum=0, maximum=255)
+
+        config["tasks"].append({
+            "name": task.name,
+            "entry": entry,
+            "priority": priority,
+            "threshold": integer(task, "THRESHOLD", default=priority, minimum=priority, maximum=255),
+            "autostart": boolean(task, "AUTOSTART"),
+            "class": task_class,
+            "context_id": context_id if "EXTENDED" == task_class else 0,
+            "stack": integer(task, "STACK", default=0, minimum=1, maximum=0x200),
+            "period": period,
+            "deadline": deadline,
+            "watchdog": integer(task, "WATCHDOG", default=0, minimum=1, maximum=MAX_TICKS),
+        })
+        if "EXTENDED" == task_class:
+            context_id += 1
+
+    for alarm in alarms:
+        if ("TASK" in alarm.attributes) == ("CALLBACK" in alarm.attributes):
+            raise ConfigError("línea %d: ALARM %s necesita TASK o CALLBACK" % (alarm.line, alarm.name))
+        callback = alarm.attributes.get("CALLBACK", (None, alarm.line))[0]
+        if callback is not None and not re.match(r"[A-Za-z_]", callback):
+            raise ConfigError("línea %d: CALLBACK de %s no es una función" % (alarm.line, alarm.name))
+        autostart = boolean(alarm, "AUTOSTART")
+        config["alarms"].append({
+            "name": alarm.name,
+            "task": task_reference(*alarm.attributes["TASK"]) if callback is None else None,
+            "callback": callback,
+            "autostart": autostart,
+            "alarm_time": integer(alarm, "ALARMTIME", minimum=1) if autostart else integer(alarm, "ALARMTIME", 0),
+            "cycle_time": integer(alarm, "CYCLETIME", default=0),
+        })
+
+    for queue in queues:
+        access = 0
+        for value, line in queue.attributes.get("ACCESS", []):
+            access |= 1 << task_reference(value, line)
+        if 0 == access:
+            raise ConfigError("línea %d: QUEUE %s necesita al menos un ACCESS" % (queue.line, queue.name))
+        config["queues"].append({
+            "name": queue.name,
+            "length": integer(queue, "LENGTH", minimum=1, maximum=254),
+            "access": access,
+        })
+
+    config["extended_count"] = context_id
+    return config
+
+
+def generate_header(config, source_name):
+    lines = [
+        "/*",
+        " * os_gen_cfg.h",
+        " *",
+        " * Generado por tools/osgen.py a partir de %s. No editar, modificar %s y volver a generar." % (source_name,
+                                                                                                    source_name),
+        " */",
+        "",
+        "#ifndef OS_GEN_CFG_H_",
+        "#define OS_GEN_CFG_H_",
+        "",
+        "#include <stdint.h>",
+        "",
+        "#define NUM_TASK_MAX            ((uint8_t) %du)" % len(config["tasks"]),
+        "#define OS_EXTENDED_TASK_COUNT  ((uint8_t) %du)" % max(1, config["extended_count"]),
+        "#define OS_ALARM_COUNT          ((uint8_t) %du)" % len(config["alarms"]),
+        "#define OS_QUEUE_COUNT_MAX      (%d)" % len(config["queues"]),
+        "",
+        "/* Tareas. */",
+    ]
+    for i, task in enumerate(config["tasks"]):
+        lines.append("#define %-24s((uint8_t) %du)" % (task["name"] + "_ID", i))
+    lines += ["", "/* Alarmas. */"]
+    for i, alarm in enumerate(config["alarms"]):
+        lines.append("#define %-24s((uint8_t) %du)" % (alarm["name"] + "_ID", i))
+    if config["queues"]:
+        lines += ["", "/* Queues. */"]
+        for i, queue in enumerate(config["queues"]):
+            lines.append("#define %-24s((uint8_t) %du)" % (queue["name"] + "_ID", i))
+    lines += ["", "#endif /* OS_GEN_CFG_H_ */", ""]
+
+    return "\n".join(lines)
+
+
+def generate_source(config, source_name):
+    tasks = config["tasks"]
+    lines = [
+        "/*",
+        " * os_gen_cfg.c",
+        " *",
+        " * Generado por tools/osgen.py a partir de %s. No editar, modificar %s y volver a generar." % (source_name,
+                                                                                                    source_name),
+        " */",
+        "#include \"os_private.h\"",
+        "",
+        "#ifdef OS_STATIC_CONFIG",
+        "",
+        "/* Revisiones que dependen de os_config.h. */",
+    ]
+
+    if config["extended_count"]:
+        lines += [
+            "#if (OS_TASK_STACK_TOP - %d * OS_TASK_STACK_BYTES) < 0x0200u" % config["extended_count"],
+            "#error \"Los stacks de las tareas extendidas (%d) no caben en la RAM\"" % config["extended_count"],
+            "#endif",
+        ]
+    for task in tasks:
+        if task["stack"]:
+            lines += [
+                "#if (%d + TASK_STACK_KERNEL_BYTES) > OS_TASK_STACK_BYTES" % task["stack"],
+                "#error \"%s necesita %d bytes de stack, más TASK_STACK_KERNEL_BYTES del kernel\"" % (
+                    task["name"], task["stack"]),
+                "#endif",
+            ]
+    if any("COROUTINE" == t["class"] for t in tasks):
+        lines += ["#ifndef OS_COROUTINES", "#error \"La configuración tiene corrutinas, habilitar OS_COROUTINES\"",
+                  "#endif"]
+    if any(t["period"] for t in tasks):
+        lines += ["#ifndef OS_SCHEDULER_EDF",
+                  "#error \"La configuración tiene tareas periódicas, habilitar OS_SCHEDULER_EDF\"", "#endif"]
+    if any(a["callback"] for a in config["alarms"]):
+        lines += ["#ifndef OS_TIMER_SERVICE",
+                  "#error \"La configuración tiene alarmas con callback, habilitar OS_TIMER_SERVICE\"", "#endif"]
+    if config["queues"]:
+        lines += ["#ifndef OS_QUEUES", "#error \"La configuración tiene queues, habilitar OS_QUEUES\"", "#endif"]
+        for queue in config["queues"]:
+            lines += [
+                "#if %d > OS_QUEUE_LEN_MAX" % queue["length"],
+                "#error \"LENGTH de %s es mayor que OS_QUEUE_LEN_MAX\"" % queue["name"],
+                "#endif",
+            ]
+    else:
+        lines += ["#ifdef OS_QUEUES", "#error \"La configuración no tiene queues, deshabilitar OS_QUEUES\"",
+                  "#endif"]
+
+    lines.append("")
+    for entry in sorted({t["entry"] for t in tasks} | {a["callback"] for a in config["alarms"] if a["callback"]}):
+        lines.append("extern void %s(void);" % entry)
+
+    lines += ["", "const task_config_t os_task_config[NUM_TASK_MAX] = {"]
+    for task in tasks:
+        lines += [
+            "    [%s_ID] = {" % task["name"],
+            "        .task_function = %s," % task["entry"],
+            "        .priority = %du," % task["priority"],
+            "        .autostart = %du," % (1 if task["autostart"] else 0),
+            "        .task_class = OS_TASK_CLASS_%s," % task["class"],
+            "        .context_id = %du," % task["context_id"],
+        ]
+        if task["period"]:
+            lines += [
+                "#ifdef OS_SCHEDULER_EDF",
+                "        .period = %du," % task["period"],
+                "        .deadline = %du," % task["deadline"],
+                "#endif /* OS_SCHEDULER_EDF */",
+            ]
+        if task["threshold"] > task["priority"]:
+            lines += [
+                "#ifdef OS_PREEMPTION_THRESHOLD",
+                "        .threshold = %du," % task["threshold"],
+                "#endif /* OS_PREEMPTION_THRESHOLD */",
+            ]
+        if task["watchdog"]:
+            lines += [
+                "#ifdef OS_SUPERVISOR",
+                "        .watchdog_ticks = %du," % task["watchdog"],
+                "#endif /* OS_SUPERVISOR */",
+            ]
+        lines.append("    },")
+    lines += ["};", "", "const alarm_config_t os_alarm_config[OS_ALARM_COUNT] = {"]
+    for alarm in config["alarms"]:
+        task = "OS_TASK_ID_MAX" if alarm["callback"] else tasks[alarm["task"]]["name"] + "_ID"
+        lines += [
+            "    [%s_ID] = {" % alarm["name"],
+            "        .task_to_activate = %s," % task,
+            "        .autostart = %du," % (1 if alarm["autostart"] else 0),
+            "        .alarm_time = %du," % alarm["alarm_time"],
+            "        .cycle_time = %du," % alarm["cycle_time"],
+        ]
+        if alarm["callback"]:
+            lines += [
+                "#ifdef OS_TIMER_SERVICE",
+                "        .callback = %s," % alarm["callback"],
+                "#endif /* OS_TIMER_SERVICE */",
+            ]
+        lines.append("    },")
+    lines.append("};")
+
+    if config["queues"]:
+        lines += ["", "#ifdef OS_QUEUES", "const queue_config_t os_queue_config[OS_QUEUE_COUNT_MAX] = {"]
+        for queue in config["queues"]:
+            lines += [
+                "    [%s_ID] = {" % queue["name"],
+                "        .length = %du," % queue["length"],
+                "        .tasks_with_access = 0x%02Xu," % queue["access"],
+                "    },",
+            ]
+        lines += ["};", "#endif /* OS_QUEUES */"]
+
+    lines += ["", "#endif /* OS_STATIC_CONFIG */", ""]
+
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generador de configuración estática para Nano-RTOS.")
+    parser.add_argument("config", help="archivo de configuración (subconjunto de OIL)")
+    parser.add_argument("--out", default=os.path.join("os", "config"),
+                        help="directorio para os_gen_cfg.h y os_gen_cfg.c (default: os/config)")
+    args = parser.parse_args()
+
+    try:
+        with open(args.config, "r", encoding="utf-8") as f:
+            config = build_config(Parser(tokenize(f.read())).parse())
+    except ConfigError as e:
+        print("%s: %s" % (args.config, e), file=sys.stderr)
+        return 1
+
+    source_name = os.path.basename(args.config)
+    # Los archivos fuente del proyecto usan ISO-8859-1 (codificación por default de CCS).
+    with open(os.path.join(args.out, "os_gen_cfg.h"), "w", encoding="iso-8859-1") as f:
+        f.write(generate_header(config, source_name))
+    with open(os.path.join(args.out, "os_gen_cfg.c"), "w", encoding="iso-8859-1") as f:
+        f.write(generate_source(config, source_name))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
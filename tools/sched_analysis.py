@@ -0,0 +1,367 @@
+#!/usr/bin/env python3
+#
+# sched_analysis.py
+#
+#  Created on: Oct 18, 2026
+#      Author: Fernando Mendoza V.
+#
+"""
+Análisis de planificabilidad fuera de línea para el conjunto estático de tareas de Nano-RTOS.
+
+Calcula el tiempo de respuesta en el peor caso (WCRT) y la holgura de cada tarea con:
+
+- Prioridades fijas: análisis de tiempo de respuesta (RTA) con jitter de activación y bloqueo.
+- Prioridades fijas con umbrales de desplazamiento (OS_PREEMPTION_THRESHOLD): RTA de Wang y Saksena, con la corrección
+  de Regehr, sobre todos los trabajos del periodo ocupado.
+- EDF: prueba de demanda del procesador y WCRT con el análisis de Spuri.
+
+El análisis incluye los overheads del kernel: cada trabajo paga dos cambios de contexto (entrada y salida), y la
+ISR de systick interfiere con todas las tareas una vez por tick. Los valores de overhead vienen del archivo de entrada,
+y deben ser los medidos en hardware para la configuración que se va a programar.
+
+Formato del archivo de entrada (una directiva por línea, '#' inicia un comentario, tiempos en microsegundos):
+
+    tick_us <duración de un tick>
+    overhead context_switch <costo de un cambio de contexto>
+    overhead tick_isr <costo de una ejecución de systick_isr>
+    overhead critical_section <sección crítica más larga del kernel (bloqueo)>
+    task <nombre> <prioridad> <wcet> <periodo> [deadline] [jitter] [umbral]
+
+El periodo de una tarea activada por una alarma es el periodo de la alarma (ticks * tick_us). Si no se especifica,
+el deadline es igual al periodo. Una tarea activada por alarma tiene hasta un tick de jitter de activación. El umbral
+de desplazamiento es igual a la prioridad si no se especifica; si alguna tarea tiene un umbral mayor que su prioridad,
+el análisis de prioridades fijas usa los umbrales.
+
+Uso:
+    python3 tools/sched_analysis.py tools/tasksets/demo.txt [--policy fp|edf|both]
+
+El programa termina con código 1 si alguna tarea puede perder su deadline con la política analizada.
+"""
+
+import argparse
+import math
+import sys
+
+
+class Task:
+    def __init__(self, name, priority, wcet, period, deadline, jitter, threshold):
+        self.name = name
+        self.priority = priority
+        self.threshold = threshold
+        self.wcet = wcet
+        self.period = period
+        self.deadline = deadline
+        self.jitter = jitter
+        # WCET incluyendo los cambios de contexto de entrada y salida de cada trabajo.
+        self.cost = wcet
+
+
+class TaskSet:
+    def __init__(self):
+        self.tick_us = 1000
+        self.context_switch = 0
+        self.tick_isr = 0
+        self.critical_section = 0
+        self.tasks = []
+
+
+def parse_taskset(path):
+    taskset = TaskSet()
+
+    with open(path, "r", encoding="utf-8") as f:
+        for line_number, line in enumerate(f, start=1):
+            fields = line.split("#", 1)[0].split()
+            if not fields:
+                continue
+
+            try:
+                if "tick_us" == fields[0] and 2 == len(fields):
+                    taskset.tick_us = int(fields[1])
+                elif "overhead" == fields[0] and 3 == len(fields):
+                    if fields[1] not in ("context_switch", "tick_isr", "critical_section"):
+                        raise ValueError("overhead desconocido '%s'" % fields[1])
+                    setattr(taskset, fields[1], int(fields[2]))
+                elif "task" == fields[0] and 5 <= len(fields) <= 8:
+                    priority = int(fields[2])
+                    period = int(fields[4])
+                    deadline = int(fields[5]) if 6 <= len(fields) else period
+                    jitter = int(fields[6]) if 7 <= len(fields) else 0
+                    threshold = int(fields[7]) if 8 <= len(fields) else priority
+                    if threshold < priority:
+                        raise ValueError("el umbral de '%s' es menor que su prioridad" % fields[1])
+                    taskset.tasks.append(Task(fields[1], priority, int(fields[3]), period, deadline, jitter,
+                                              threshold))
+                else:
+                    raise ValueError("directiva inválida")
+            except ValueError as e:
+                raise SystemExit("%s:%d: %s" % (path, line_number, e))
+
+    for task in taskset.tasks:
+        if task.period <= 0 or task.wcet <= 0 or task.deadline <= 0:
+            raise SystemExit("%s: tarea '%s' debe tener wcet, periodo y deadline positivos" % (path, task.name))
+        task.cost = task.wcet + 2 * taskset.context_switch
+
+    if taskset.tick_us <= 0:
+        raise SystemExit("%s: tick_us debe ser positivo" % path)
+
+    return taskset
+
+
+def tick_interference(taskset, window):
+    """Tiempo que consume systick_isr dentro de una ventana de duración window."""
+    return math.ceil(window / taskset.tick_us) * taskset.tick_isr
+
+
+def fixed_priority_rta(taskset):
+    """
+    RTA para prioridades fijas. Las tareas con la misma prioridad se consideran interferencia mutua, porque el orden
+    entre ellas depende del ID o del round-robin.
+
+    Regresa un diccionario nombre -> WCRT, o None si la iteración no converge antes del deadline.
+    """
+    results = {}
+
+    for task in taskset.tasks:
+        interfering = [t for t in taskset.tasks if t is not task and t.priority >= task.priority]
+        blocking = taskset.critical_section
+
+        response = task.cost + blocking
+        while True:
+            demand = task.cost + blocking + tick_interference(taskset, response)
+            for other in interfering:
+                demand += math.ceil((response + other.jitter) / other.period) * other.cost
+
+            if demand == response:
+                break
+
+            response = demand
+            if response + task.jitter > task.deadline:
+                # No converge dentro del deadline, la tarea no es planificable.
+                response = None
+                break
+
+        results[task.name] = None if response is None else response + task.jitter
+
+    return results
+
+
+def preemption_threshold_rta(taskset):
+    """
+    RTA para prioridades fijas con umbrales de desplazamiento. Antes de comenzar, un trabajo espera a las tareas con
+    prioridad mayor o igual; después de comenzar, solo lo desplazan las tareas con prioridad mayor que su umbral (o con
+    su misma prioridad, por round-robin, si no tiene umbral). Una tarea de menor prioridad con umbral mayor o igual que
+    la prioridad de la tarea analizada puede bloquearla durante todo su WCET.
+
+    Como un trabajo puede retrasar al siguiente trabajo de la misma tarea, se analizan todos los trabajos del periodo
+    ocupado de nivel de la prioridad de la tarea.
+
+    Regresa un diccionario nombre -> WCRT, o None si algún trabajo no termina antes del deadline.
+    """
+    results = {}
+
+    for task in taskset.tasks:
+        before = [t for t in taskset.tasks if t is not task and t.priority >= task.priority]
+        if task.threshold > task.priority:
+            after = [t for t in taskset.tasks if t.priority > task.threshold]
+        else:
+            after = before
+        blocking = max([taskset.critical_section] +
+                       [t.cost for t in taskset.tasks if t.priority < task.priority <= t.threshold])
+
+        utilization = sum(t.cost / t.period for t in before + [task]) + taskset.tick_isr / taskset.tick_us
+        if utilization >= 1.0:
+            results[task.name] = None
+            continue
+
+        busy_period = blocking + task.cost
+        while True:
+            demand = blocking + tick_interference(taskset, busy_period)
+            demand += sum(math.ceil((busy_period + t.jitter) / t.period) * t.cost for t in before + [task])
+            if demand == busy_period:
+                break
+            busy_period = demand
+
+        worst = 0
+        for job in range(math.ceil((busy_period + task.jitter) / task.period)):
+            # Inicio del trabajo: bloqueo, trabajos anteriores de la tarea y tareas que llegan antes del inicio.
+            start = blocking + job * task.cost
+            while True:
+                demand = blocking + job * task.cost + tick_interference(taskset, start)
+                demand += sum((1 + math.floor((start + t.jitter) / t.period)) * t.cost for t in before)
+                if demand == start:
+                    break
+                start = demand
+
+            # Fin del trabajo: solo las tareas que pueden desplazarlo después del inicio.
+            finish = start + task.cost
+            while True:
+                demand = start + task.cost + tick_interference(taskset, finish) - tick_interference(taskset, start)
+                demand += sum((math.ceil((finish + t.jitter) / t.period) - 1 - math.floor((start + t.jitter) / t.period))
+                              * t.cost for t in after)
+                if demand == finish:
+                    break
+                finish = demand
+
+            worst = max(worst, finish - job * task.period + task.jitter)
+            if worst > task.deadline:
+                break
+
+        results[task.name] = None if worst > task.deadline else worst
+
+    return results
+
+
+def edf_busy_period(taskset):
+    """Duración del periodo ocupado síncrono, incluyendo overhead de systick."""
+    length = sum(t.cost for t in taskset.tasks)
+    while True:
+        demand = tick_interference(taskset, length)
+        demand += sum(math.ceil(length / t.period) * t.cost for t in taskset.tasks)
+        if demand == length:
+            return length
+        length = demand
+
+
+def edf_utilization(taskset):
+    return sum(t.cost / t.period for t in taskset.tasks) + taskset.tick_isr / taskset.tick_us
+
+
+def edf_demand_test(taskset, busy_period):
+    """
+    Prueba de demanda del procesador: para cada deadline absoluto t dentro del periodo ocupado, la demanda de trabajo
+    con deadline <= t no puede exceder t.
+
+    Regresa el primer deadline absoluto donde la prueba falla, o None si el conjunto es planificable.
+    """
+    deadlines = sorted({k * t.period + t.deadline
+                        for t in taskset.tasks
+                        for k in range(int(busy_period // t.period) + 1)
+                        if k * t.period + t.deadline <= busy_period})
+
+    for point in deadlines:
+        demand = tick_interference(taskset, point) + taskset.critical_section
+        for t in taskset.tasks:
+            if point >= t.deadline:
+                demand += (math.floor((point - t.deadline) / t.period) + 1) * t.cost
+        if demand > point:
+            return point
+
+    return None
+
+
+def edf_rta(taskset, busy_period):
+    """
+    WCRT de cada tarea con EDF (análisis de Spuri). Para cada instante de activación a de la tarea analizada dentro
+    del periodo ocupado, calcula el fin del periodo ocupado de deadline a + D.
+    """
+    results = {}
+
+    for task in taskset.tasks:
+        offsets = {0}
+        for other in taskset.tasks:
+            k = 0
+            while True:
+                a = k * other.period + other.deadline - task.deadline
+                if a >= busy_period:
+                    break
+                if a >= 0:
+                    offsets.add(a)
+                k += 1
+
+        worst = 0
+        for a in sorted(offsets):
+            absolute_deadline = a + task.deadline
+            own_jobs = math.floor(a / task.period) + 1
+
+            length = own_jobs * task.cost
+            while True:
+                demand = own_jobs * task.cost + taskset.critical_section + tick_interference(taskset, length)
+                for other in taskset.tasks:
+                    if other is task or other.deadline > absolute_deadline:
+                        continue
+                    jobs = min(math.ceil(length / other.period),
+                               math.floor((absolute_deadline - other.deadline) / other.period) + 1)
+                    demand += jobs * other.cost
+                if demand == length:
+                    break
+                length = demand
+                if length > busy_period + task.deadline:
+                    break
+
+            worst = max(worst, length - a)
+
+        results[task.name] = worst + task.jitter
+
+    return results
+
+
+def print_report(title, taskset, responses):
+    schedulable = True
+
+    print(title)
+    print("  %-16s %5s %9s %9s %9s %9s %9s  %s" % ("tarea", "prio", "C (us)", "T (us)", "D (us)", "R (us)",
+                                                    "holgura", "estado"))
+    for task in sorted(taskset.tasks, key=lambda t: (-t.priority, t.name)):
+        response = responses[task.name]
+        if response is None or response > task.deadline:
+            schedulable = False
+            status = "PIERDE DEADLINE"
+            response_text = "> D" if response is None else str(response)
+            slack_text = "-"
+        else:
+            status = "ok"
+            response_text = str(response)
+            slack_text = str(task.deadline - response)
+
+        print("  %-16s %5d %9d %9d %9d %9s %9s  %s" % (task.name, task.priority, task.cost, task.period,
+                                                        task.deadline, response_text, slack_text, status))
+    print()
+
+    return schedulable
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Análisis de planificabilidad para Nano-RTOS.")
+    parser.add_argument("taskset", help="archivo con el conjunto de tareas")
+    parser.add_argument("--policy", choices=("fp", "edf", "both"), default="both",
+                        help="política del scheduler a analizar (default: both)")
+    args = parser.parse_args()
+
+    taskset = parse_taskset(args.taskset)
+    if not taskset.tasks:
+        raise SystemExit("%s: no hay tareas" % args.taskset)
+
+    utilization = edf_utilization(taskset)
+    print("Utilización con overheads: %.1f %%" % (100.0 * utilization))
+    print("Overheads: cambio de contexto %d us, systick_isr %d us cada %d us, sección crítica %d us"
+          % (taskset.context_switch, taskset.tick_isr, taskset.tick_us, taskset.critical_section))
+    print()
+
+    schedulable = True
+
+    if args.policy in ("fp", "both"):
+        if any(t.threshold > t.priority for t in taskset.tasks):
+            schedulable &= print_report("Prioridades fijas con umbrales de desplazamiento (RTA):", taskset,
+                                        preemption_threshold_rta(taskset))
+        else:
+            schedulable &= print_report("Prioridades fijas (RTA):", taskset, fixed_priority_rta(taskset))
+
+    if args.policy in ("edf", "both"):
+        if utilization > 1.0:
+            print("EDF: utilización mayor que 100 %, el conjunto no es planificable.")
+            print()
+            schedulable = False
+        else:
+            busy_period = edf_busy_period(taskset)
+            failed_at = edf_demand_test(taskset, busy_period)
+            if failed_at is not None:
+                print("EDF: la demanda del procesador excede el tiempo disponible en t = %d us." % failed_at)
+            schedulable &= print_report("EDF (periodo ocupado %d us):" % busy_period, taskset,
+                                        edf_rta(taskset, busy_period))
+            schedulable &= failed_at is None
+
+    return 0 if schedulable else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())